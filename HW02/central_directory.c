@@ -0,0 +1,79 @@
+#include <stdio.h>
+#include "central_directory.h"
+
+/**
+ * Чтение беззнаковых little-endian чисел из буфера
+ */
+uint16_t read_u16(const unsigned char *p) {
+    return (uint16_t) (p[0] | (p[1] << 8));
+}
+
+uint32_t read_u32(const unsigned char *p) {
+    return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+/**
+ * Проверка наличия в участке n байт начиная с позиции pos (без переполнения при сложении)
+ * @return 1|0 - 1 байты есть | 0 выход за границы
+ */
+static int span_has(span s, size_t pos, size_t n) {
+    return pos <= s.len && n <= s.len - pos;
+}
+
+/**
+ * Поиск последней записи eocdr в хвосте файла
+ * @param tail - хвост файла
+ * @param pos - позиция сигнатуры eocdr в хвосте
+ * @return 1|0 - 1 eocdr найден | 0 не найден
+ */
+int find_eocdr_in(span tail, size_t *pos) {
+    if (tail.len < EOCDR_SIZE) {
+        return 0;
+    }
+    size_t i = tail.len - EOCDR_SIZE + 1;
+    while (i-- > 0) {
+        if (read_u32(tail.data + i) == EOCDR_SIGNATURE) {
+            *pos = i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Проверка согласованности eocdr: центральный каталог должен помещаться перед eocdr,
+ * а заявленное кол-во записей - в размер каталога
+ * @param eocdr_offset - позиция eocdr от начала файла
+ * @param cd_size - размер центрального каталога из eocdr
+ * @param count - кол-во записей центрального каталога из eocdr
+ * @return 1|0 - 1 eocdr корректен | 0 некорректен
+ */
+int eocdr_valid(unsigned long eocdr_offset, uint32_t cd_size, uint16_t count) {
+    return cd_size <= eocdr_offset && (size_t) count * CFH_FIXED_SIZE <= cd_size;
+}
+
+/**
+ * Вывод названий файлов центрального каталога, прочитанного в память
+ * @param cd - центральный каталог
+ * @param count - кол-во записей центрального каталога
+ * @return 0|-1 - 0 каталог разобран | -1 каталог поврежден
+ */
+int print_central_directory(span cd, uint16_t count) {
+    size_t pos = 0;
+    for (uint16_t i = 0; i < count; ++i) {
+        if (!span_has(cd, pos, CFH_FIXED_SIZE) || read_u32(cd.data + pos) != CFH_SIGNATURE) {
+            printf("ERROR: не найдена сигнатура центрального каталога\n");
+            return -1;
+        }
+        size_t name_len = read_u16(cd.data + pos + 28);
+        size_t var_len = name_len + read_u16(cd.data + pos + 30) + read_u16(cd.data + pos + 32);
+        pos += CFH_FIXED_SIZE;
+        if (!span_has(cd, pos, var_len)) {
+            printf("ERROR: запись центрального каталога выходит за его границы\n");
+            return -1;
+        }
+        printf("%.*s\n", (int) name_len, (const char *) cd.data + pos);
+        pos += var_len;
+    }
+    return 0;
+}
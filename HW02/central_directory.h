@@ -0,0 +1,27 @@
+#ifndef CENTRAL_DIRECTORY_H
+#define CENTRAL_DIRECTORY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define EOCDR_SIGNATURE 0x06054b50
+#define CFH_SIGNATURE 0x02014b50
+#define EOCDR_SIZE 22 // размер eocdr без комментария
+#define CFH_FIXED_SIZE 46 // размер записи центрального каталога без имени, extra и комментария
+
+/**
+ * Участок данных в памяти. Все чтения из него проверяются на выход за границы,
+ * т.к. размеры и смещения берутся из файла и могут быть произвольными
+ */
+typedef struct {
+    const unsigned char *data;
+    size_t len;
+} span;
+
+uint16_t read_u16(const unsigned char *p);
+uint32_t read_u32(const unsigned char *p);
+int find_eocdr_in(span tail, size_t *pos);
+int eocdr_valid(unsigned long eocdr_offset, uint32_t cd_size, uint16_t count);
+int print_central_directory(span cd, uint16_t count);
+
+#endif
@@ -1,10 +1,20 @@
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
-
-#define EOCDR_SIGNATURE 0x06054b50
-#define CFH_SIGNATURE 0x02014b50
+#include <stddef.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+#include "central_directory.h"
 
 typedef struct {
     uint16_t disk_number;        /* Number of this disk. */
@@ -31,54 +41,488 @@ unsigned long filesize(FILE *fp) {
 }
 
 /**
- * Поиск позиции eocdr
- * @param fp - указатель на поток файла в котором изем eocdr
- * @return 0|<unsigned long> - 0 eocdr не найден | <unsigned long> позиция eocdr от начала файла
+ * Сигнатура формата архива, который может быть дописан в конец картинки
+ */
+typedef struct {
+    const char *name; // название формата
+    const unsigned char *magic; // байты сигнатуры
+    size_t len; // длина сигнатуры в байтах
+    int keep_last; // 1 - запоминаем последнее вхождение (eocdr zip), 0 - первое (начало архива rar/7z)
+} signature;
+
+enum { SIG_ZIP, SIG_RAR, SIG_RAR5, SIG_7Z, SIG_COUNT };
+
+#define SIG_MAX_LEN 8
+#define SCAN_CHUNK 65536
+
+static const signature signatures[SIG_COUNT] = {
+    [SIG_ZIP] = {"zip", (const unsigned char *) "PK\x05\x06", 4, 1},
+    [SIG_RAR] = {"rar", (const unsigned char *) "Rar!\x1a\x07\x00", 7, 0},
+    [SIG_RAR5] = {"rar5", (const unsigned char *) "Rar!\x1a\x07\x01\x00", 8, 0},
+    [SIG_7Z] = {"7z", (const unsigned char *) "7z\xbc\xaf\x27\x1c", 6, 0},
+};
+
+/**
+ * Результат сканирования файла: позиция найденной сигнатуры каждого формата
+ */
+typedef struct {
+    int found[SIG_COUNT]; // 1 - сигнатура формата найдена
+    unsigned long offset[SIG_COUNT]; // позиция сигнатуры от начала файла
+} scan_result;
+
+/**
+ * Таблица первых байт сигнатур: для каждого байта битовая маска форматов, сигнатура которых с него начинается.
+ * Позволяет за один проход по данным проверять все сигнатуры сразу, сравнивая только кандидатов.
+ * @param table - заполняемая таблица
+ */
+static void build_first_byte_table(uint8_t table[256]) {
+    memset(table, 0, 256);
+    for (int i = 0; i < SIG_COUNT; ++i) {
+        table[signatures[i].magic[0]] |= (uint8_t) (1u << i);
+    }
+}
+
+/**
+ * Поиск сигнатур всех известных форматов архивов за один проход по всему файлу, от начала до конца.
+ * Просматривается весь файл, а не только хвост: сигнатура rar/7z стоит в начале дописанного архива,
+ * который может быть сколь угодно большим, поэтому окно хвоста ее не гарантирует
+ * @param fp - указатель на поток файла в котором ищем сигнатуры
+ * @param result - структура куда записываем позиции найденных сигнатур
  */
-unsigned long find_eocdr(FILE *fp) {
+void scan_signatures(FILE *fp, scan_result *result) {
+    static uint8_t first_byte[256];
+    static unsigned char buf[SCAN_CHUNK + SIG_MAX_LEN];
     unsigned long fp_size = filesize(fp);
-    unsigned long offset;
-    // Перебираем по байтам, с конца файла минус размер структуры eocdr, в поисках сигнатуры блока eocdr
-    for (offset = fp_size - sizeof(eocdr); offset != 0; --offset) {
-        uint32_t signature = 0;
-
-        // Непосредственно смещение позиции на заданный размер с конца файла
-        if (fseek(fp, offset, SEEK_SET) != 0) {
-            printf("ERROR: Не удалось сместить позицию в файле.\n");
-            fclose(fp);
-            exit(1);
+
+    memset(result, 0, sizeof(scan_result));
+    build_first_byte_table(first_byte);
+
+    if (fseek(fp, 0L, SEEK_SET) != 0) {
+        printf("ERROR: Не удалось сместить позицию в файле.\n");
+        fclose(fp);
+        exit(1);
+    }
+
+    /**
+     * Читаем файл блоками. Последние SIG_MAX_LEN - 1 байт блока переносим в начало следующего,
+     * чтобы не пропустить сигнатуру, попавшую на границу блоков.
+     */
+    unsigned long base = 0; // позиция начала буфера от начала файла
+    size_t kept = 0; // кол-во перенесенных байт предыдущего блока
+    size_t got;
+    while ((got = fread(buf + kept, 1, SCAN_CHUNK, fp)) > 0) {
+        size_t len = kept + got;
+        int last = base + len >= fp_size;
+        // в середине файла проверяем только позиции, после которых гарантированно хватит байт на любую сигнатуру
+        size_t limit = last ? len : len - (SIG_MAX_LEN - 1);
+
+        for (size_t i = 0; i < limit; ++i) {
+            uint8_t candidates = first_byte[buf[i]];
+            if (!candidates) {
+                continue;
+            }
+            for (int s = 0; s < SIG_COUNT; ++s) {
+                if (!(candidates & (1u << s)) || i + signatures[s].len > len
+                    || memcmp(buf + i, signatures[s].magic, signatures[s].len) != 0) {
+                    continue;
+                }
+                if (!result->found[s] || signatures[s].keep_last) {
+                    result->found[s] = 1;
+                    result->offset[s] = base + i;
+                }
+            }
         }
 
-        // Читаем из файла 4 байта и проверяем равно ли значение в них сигнатуре eocdr zip
-        fread(&signature, sizeof(uint32_t), 1, fp);
-        if (signature == EOCDR_SIGNATURE) {
+        if (last) {
             break;
         }
+        kept = len - limit;
+        memmove(buf, buf + limit, kept);
+        base += limit;
     }
-
-    return offset;
 }
 
 /**
  * Читаем блок eocdr
  * @param fp - указатель на поток файла
+ * @param offset - позиция сигнатуры eocdr от начала файла
  * @param end_record - структура куда считываем eocdr
- * @return 0|<offset> - 0 если не нашли запись eocdr | <offset> позиция записи eocdr
+ * @return 0|1 - 0 не удалось прочитать eocdr | 1 eocdr прочитан
+ */
+int read_eocdr(FILE *fp, unsigned long offset, eocdr *end_record) {
+    if (fseek(fp, offset + sizeof(uint32_t), SEEK_SET) != 0) {
+        printf("ERROR: Не удалось сместить позицию в файле (read_eocdr).\n");
+        fclose(fp);
+        exit(1);
+    }
+
+    // читаем без учета выравнивания в конце структуры, т.к. eocdr без комментария заканчивается вместе с файлом
+    size_t record_size = offsetof(eocdr, comment_length) + sizeof(uint16_t);
+    return fread(end_record, record_size, 1, fp) == 1;
+}
+
+/**
+ * Максимальный размер хвоста файла, в котором может находиться eocdr:
+ * сама запись (22 байта) и комментарий архива длиной до 65535 байт
+ */
+#define TAIL_MAX (EOCDR_SIZE + 65535)
+#define DEFAULT_QUEUE_DEPTH 32
+
+/**
+ * Состояние обработки одного файла в пакетном режиме
+ */
+typedef enum { JOB_TAIL, JOB_CD, JOB_DONE } job_stage;
+
+typedef struct {
+    const char *path; // путь к файлу
+    int fd; // дескриптор файла
+    job_stage stage; // текущий этап чтения
+    unsigned char *buf; // буфер текущего чтения
+    size_t len; // размер чтения
+    size_t done; // прочитано байт текущего чтения, остаток дочитывается повторным запросом
+    off_t offset; // позиция чтения от начала файла
+    uint16_t entries; // кол-во записей центрального каталога
+} tail_job;
+
+/**
+ * Минимальная обертка над io_uring без liburing: кольца отправки и завершения, отображенные в память
+ */
+typedef struct {
+    int fd;
+    unsigned *sq_head, *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sq_ptr, *cq_ptr;
+    size_t sq_size, cq_size, sqes_size;
+    unsigned pending; // кол-во заполненных, но не отправленных в ядро запросов
+} uring;
+
+/**
+ * Инициализация io_uring
+ * @param ring - инициализируемая структура
+ * @param depth - глубина очереди
+ * @return 0|-1 - 0 успешно | -1 io_uring недоступен
+ */
+static int uring_init(uring *ring, unsigned depth) {
+#ifdef __linux__
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    memset(ring, 0, sizeof(uring));
+    ring->fd = (int) syscall(__NR_io_uring_setup, depth, &p);
+    if (ring->fd < 0) {
+        return -1;
+    }
+
+    ring->sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    ring->cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cq_size > ring->sq_size) {
+            ring->sq_size = ring->cq_size;
+        }
+        ring->cq_size = ring->sq_size;
+    }
+    ring->sq_ptr = mmap(NULL, ring->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        ring->fd, IORING_OFF_SQ_RING);
+    if (ring->sq_ptr == MAP_FAILED) {
+        close(ring->fd);
+        return -1;
+    }
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_ptr = ring->sq_ptr;
+    } else {
+        ring->cq_ptr = mmap(NULL, ring->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            ring->fd, IORING_OFF_CQ_RING);
+        if (ring->cq_ptr == MAP_FAILED) {
+            munmap(ring->sq_ptr, ring->sq_size);
+            close(ring->fd);
+            return -1;
+        }
+    }
+    ring->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring->fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        if (ring->cq_ptr != ring->sq_ptr) {
+            munmap(ring->cq_ptr, ring->cq_size);
+        }
+        munmap(ring->sq_ptr, ring->sq_size);
+        close(ring->fd);
+        return -1;
+    }
+
+    char *sq = ring->sq_ptr, *cq = ring->cq_ptr;
+    ring->sq_head = (unsigned *) (sq + p.sq_off.head);
+    ring->sq_tail = (unsigned *) (sq + p.sq_off.tail);
+    ring->sq_mask = (unsigned *) (sq + p.sq_off.ring_mask);
+    ring->sq_array = (unsigned *) (sq + p.sq_off.array);
+    ring->cq_head = (unsigned *) (cq + p.cq_off.head);
+    ring->cq_tail = (unsigned *) (cq + p.cq_off.tail);
+    ring->cq_mask = (unsigned *) (cq + p.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *) (cq + p.cq_off.cqes);
+    return 0;
+#else
+    (void) ring;
+    (void) depth;
+    return -1;
+#endif
+}
+
+static void uring_free(uring *ring) {
+#ifdef __linux__
+    munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ptr != ring->sq_ptr) {
+        munmap(ring->cq_ptr, ring->cq_size);
+    }
+    munmap(ring->sq_ptr, ring->sq_size);
+    close(ring->fd);
+#else
+    (void) ring;
+#endif
+}
+
+/**
+ * Постановка в очередь чтения для задания (отправляется в ядро в uring_wait)
+ */
+static void uring_queue_read(uring *ring, tail_job *job) {
+#ifdef __linux__
+    unsigned tail = *ring->sq_tail;
+    unsigned index = tail & *ring->sq_mask;
+    struct io_uring_sqe *sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = job->fd;
+    sqe->addr = (uint64_t) (uintptr_t) (job->buf + job->done);
+    sqe->len = (uint32_t) (job->len - job->done);
+    sqe->off = (uint64_t) (job->offset + (off_t) job->done);
+    sqe->user_data = (uint64_t) (uintptr_t) job;
+    ring->sq_array[index] = index;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ring->pending++;
+#else
+    (void) ring;
+    (void) job;
+#endif
+}
+
+/**
+ * Отправка накопленных запросов и ожидание хотя бы одного завершения
+ * @param ring - io_uring
+ * @param job - завершенное задание
+ * @param res - результат чтения (кол-во байт или -errno)
+ * @return 0|-1 - 0 получено завершение | -1 ошибка io_uring_enter
+ */
+static int uring_wait(uring *ring, tail_job **job, int *res) {
+#ifdef __linux__
+    unsigned head = *ring->cq_head;
+    while (head == __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+        long submitted = syscall(__NR_io_uring_enter, ring->fd, ring->pending, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+        if (submitted < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        // ядро могло принять не все запросы, остальные остаются в очереди до следующего вызова
+        ring->pending -= (unsigned) submitted;
+    }
+    struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+    *job = (tail_job *) (uintptr_t) cqe->user_data;
+    *res = cqe->res;
+    __atomic_store_n(ring->cq_head, head + 1, __ATOMIC_RELEASE);
+    return 0;
+#else
+    (void) ring;
+    (void) job;
+    (void) res;
+    return -1;
+#endif
+}
+
+/**
+ * Начало обработки файла: открытие и подготовка чтения хвоста с eocdr
+ * @return 0|-1 - 0 чтение подготовлено | -1 обработка завершена (файл не удалось открыть или он пуст)
+ */
+static int job_start(tail_job *job) {
+    struct stat st;
+    if ((job->fd = open(job->path, O_RDONLY)) < 0 || fstat(job->fd, &st) != 0) {
+        printf("%s:\nНе удалось открыть файл\n", job->path);
+        if (job->fd >= 0) {
+            close(job->fd);
+        }
+        job->stage = JOB_DONE;
+        return -1;
+    }
+    // пустой файл: читать нечего, результат как в режиме одного файла
+    if (st.st_size == 0) {
+        printf("%s:\nФайл не содержит архивов.\n", job->path);
+        close(job->fd);
+        job->stage = JOB_DONE;
+        return -1;
+    }
+    job->len = (size_t) st.st_size < TAIL_MAX ? (size_t) st.st_size : TAIL_MAX;
+    job->offset = st.st_size - (off_t) job->len;
+    job->done = 0;
+    job->buf = malloc(job->len);
+    if (job->buf == NULL) {
+        printf("ERROR: Не удалось выделить память.\n");
+        exit(1);
+    }
+    job->stage = JOB_TAIL;
+    return 0;
+}
+
+static void job_finish(tail_job *job) {
+    free(job->buf);
+    job->buf = NULL;
+    close(job->fd);
+    job->stage = JOB_DONE;
+}
+
+/**
+ * Обработка завершенного чтения задания
+ * @param job - задание
+ * @param res - кол-во прочитанных байт или -errno
+ * @return 1|0 - 1 требуется следующее чтение (остаток текущего или центральный каталог) | 0 обработка файла завершена
  */
-unsigned long read_eocdr(FILE *fp, eocdr *end_record) {
-    if(find_eocdr(fp) == 0) {
+static int job_complete(tail_job *job, ssize_t res) {
+    // 0 байт до конца чтения - файл стал короче, чем при открытии
+    if (res <= 0) {
+        printf("%s:\nНе удалось прочитать файл\n", job->path);
+        job_finish(job);
         return 0;
     }
 
-    // Смещаемся от конца файла на минимальный
-    if (fseek(fp, find_eocdr(fp)+ sizeof(uint32_t), SEEK_SET) != 0) {
-        printf("ERROR: Не удалось сместить позицию в файле (read_eocdr).\n");
-        fclose(fp);
+    // короткое чтение: дочитываем остаток
+    job->done += (size_t) res;
+    if (job->done < job->len) {
+        return 1;
+    }
+
+    if (job->stage == JOB_CD) {
+        printf("%s:\n", job->path);
+        print_central_directory((span) {job->buf, job->len}, job->entries);
+        job_finish(job);
+        return 0;
+    }
+
+    span tail = {job->buf, job->len};
+    size_t pos;
+    if (!find_eocdr_in(tail, &pos)) {
+        printf("%s:\nФайл не содержит zip архива.\n", job->path);
+        job_finish(job);
+        return 0;
+    }
+
+    job->entries = read_u16(job->buf + pos + 10);
+    uint32_t cd_size = read_u32(job->buf + pos + 12);
+    off_t eocd_offset = job->offset + (off_t) pos;
+    if (!eocdr_valid((unsigned long) eocd_offset, cd_size, job->entries)) {
+        printf("%s:\nНекорректный размер центрального каталога\n", job->path);
+        job_finish(job);
+        return 0;
+    }
+
+    // центральный каталог целиком в уже прочитанном хвосте - второе чтение не требуется
+    if ((size_t) cd_size <= pos) {
+        printf("%s:\n", job->path);
+        print_central_directory((span) {job->buf + pos - cd_size, cd_size}, job->entries);
+        job_finish(job);
+        return 0;
+    }
+
+    free(job->buf);
+    job->len = cd_size;
+    job->offset = eocd_offset - (off_t) cd_size;
+    job->done = 0;
+    job->buf = malloc(job->len ? job->len : 1);
+    if (job->buf == NULL) {
+        printf("ERROR: Не удалось выделить память.\n");
+        exit(1);
+    }
+    job->stage = JOB_CD;
+    return 1;
+}
+
+/**
+ * Синхронная обработка задания через pread до завершения
+ */
+static void job_run_sync(tail_job *job) {
+    int again;
+    do {
+        ssize_t res = pread(job->fd, job->buf + job->done, job->len - job->done, job->offset + (off_t) job->done);
+        again = job_complete(job, res < 0 ? -errno : res);
+    } while (again);
+}
+
+/**
+ * Пакетная обработка файлов: чтения хвостов и центральных каталогов выполняются
+ * одновременно для depth файлов через io_uring. Если io_uring недоступен или ядро не поддерживает
+ * IORING_OP_READ (до 5.6, чтение завершается с -EINVAL) - синхронно через pread.
+ * @param paths - пути к файлам
+ * @param count - кол-во файлов
+ * @param depth - глубина очереди (кол-во одновременно обрабатываемых файлов)
+ */
+void scan_batch(char **paths, int count, unsigned depth) {
+    tail_job *jobs = calloc((size_t) count, sizeof(tail_job));
+    if (jobs == NULL) {
+        printf("ERROR: Не удалось выделить память.\n");
         exit(1);
     }
-    fread(end_record, sizeof(eocdr), 1, fp);
+    for (int i = 0; i < count; ++i) {
+        jobs[i].path = paths[i];
+    }
+
+    uring ring;
+    if (uring_init(&ring, depth) != 0) {
+        // синхронный вариант с той же логикой обработки
+        for (int i = 0; i < count; ++i) {
+            if (job_start(&jobs[i]) == 0) {
+                job_run_sync(&jobs[i]);
+            }
+        }
+        free(jobs);
+        return;
+    }
+
+    int next = 0; // следующий файл для постановки в очередь
+    unsigned in_flight = 0;
+    int no_read_op = 0; // 1 - ядро не поддерживает IORING_OP_READ, новые файлы читаются через pread
+    while (next < count || in_flight > 0) {
+        while (next < count && in_flight < depth) {
+            if (job_start(&jobs[next]) == 0) {
+                if (no_read_op) {
+                    job_run_sync(&jobs[next]);
+                } else {
+                    uring_queue_read(&ring, &jobs[next]);
+                    in_flight++;
+                }
+            }
+            next++;
+        }
+        if (in_flight == 0) {
+            continue;
+        }
+
+        tail_job *job;
+        int res;
+        if (uring_wait(&ring, &job, &res) != 0) {
+            printf("ERROR: Ошибка io_uring.\n");
+            exit(1);
+        }
+        if (res == -EINVAL) {
+            no_read_op = 1;
+            job_run_sync(job);
+            in_flight--;
+        } else if (job_complete(job, res)) {
+            uring_queue_read(&ring, job);
+        } else {
+            in_flight--;
+        }
+    }
 
-    return find_eocdr(fp);
+    uring_free(&ring);
+    free(jobs);
 }
 
 int main(int argc, char *argv[]) {
@@ -88,58 +532,83 @@ int main(int argc, char *argv[]) {
         exit(1);
     }
 
+    /**
+     * Пакетный режим: main [-q <глубина очереди>] <файл> <файл> ...
+     * Для каждого файла выводится содержимое zip архива, чтения выполняются асинхронно через io_uring
+     */
+    if (!strcmp(argv[1], "-q") || argc > 2) {
+        unsigned depth = DEFAULT_QUEUE_DEPTH;
+        int first = 1;
+        if (!strcmp(argv[1], "-q")) {
+            if (argc < 4 || (depth = (unsigned) strtoul(argv[2], NULL, 10)) == 0) {
+                printf("ERROR: Некорректная глубина очереди.\n");
+                exit(1);
+            }
+            first = 3;
+        }
+        scan_batch(&argv[first], argc - first, depth);
+        return 0;
+    }
+
     FILE *fp;
     if ((fp = fopen(argv[1], "r")) == NULL) {
         printf("Не удалось открыть файл результата '%s'\n", argv[1]);
         exit(1);
     }
 
+    scan_result scan;
+    scan_signatures(fp, &scan);
+    int found_any = 0;
+    for (int s = 0; s < SIG_COUNT; ++s) {
+        if (scan.found[s]) {
+            printf("Найдена сигнатура %s по смещению %lu\n", signatures[s].name, scan.offset[s]);
+            found_any = 1;
+        }
+    }
+    if (!found_any) {
+        fclose(fp);
+        printf("Файл %s не содержит архивов.\n", argv[1]);
+        return 0;
+    }
+
     eocdr end_record;
-    unsigned long offset = read_eocdr(fp, &end_record);
-    if (offset == 0) {
+    unsigned long offset = scan.offset[SIG_ZIP];
+    if (!scan.found[SIG_ZIP] || !read_eocdr(fp, offset, &end_record)) {
         fclose(fp);
         printf("Файл %s не содержит zip архива.\n", argv[1]);
         return 0;
     }
 
+    uint32_t cd_size = end_record.size_of_central_directory;
+    uint16_t count = end_record.total_central_directory_record;
+    if (!eocdr_valid(offset, cd_size, count)) {
+        fclose(fp);
+        printf("ERROR: Некорректный размер центрального каталога\n");
+        exit(1);
+    }
+
     /**
-     * Смещаемся на первую запись центрального каталога.
+     * Читаем центральный каталог в память целиком и разбираем его с проверкой границ.
      * Т.к. мы не знаем размер картинки положение центрального каталога получаем не исходя из значения
      * смещения от начала файла указанного в блоке eocdr, а путем вычитания размера центрального каталога
      * от позиции начала блока eocdr
      */
-    fseek(fp, offset - end_record.size_of_central_directory, SEEK_SET);
-    for (uint16_t i = 0; i < end_record.total_central_directory_record; ++i) {
-        uint32_t signature;
-        fread(&signature, sizeof(uint32_t), 1, fp);
-        if (signature != CFH_SIGNATURE) {
-            printf("ERROR: не найдена сигнатура центрального каталога\n");
-            break;
-        }
-
-        // Перемещаемся на позицию где начинаются указания на размеры переменных величин (длина название файла, дополнительное поле, длина комментария)
-        fseek(fp, 24, SEEK_CUR);
-        // Получаем размеры переменных велечин
-        uint16_t name_len, extra_len, comment_len;
-        fread(&name_len, sizeof(uint16_t), 1, fp);
-        fread(&extra_len, sizeof(uint16_t), 1, fp);
-        fread(&comment_len, sizeof(uint16_t), 1, fp);
-
-        // Перемещаемся на позицию названия файла
-        fseek(fp, 12, SEEK_CUR);
-        char name[name_len]; // строка название файла длиною полученной раннее (name_len)
-        fread(&name, name_len, 1, fp);
-        // Вывод названия файла
-        for (int j = 0; j < name_len; ++j) {
-            printf("%c", name[j]);
-        }
-        printf("\n");
-
-        // Смещаем текущую позицию чтения файла на размер непрочитанных блоков
-        fseek(fp, extra_len+comment_len, SEEK_CUR);
+    unsigned char *cd = malloc(cd_size ? cd_size : 1);
+    if (cd == NULL) {
+        fclose(fp);
+        printf("ERROR: Не удалось выделить память.\n");
+        exit(1);
     }
+    if (fseek(fp, offset - cd_size, SEEK_SET) != 0 || fread(cd, 1, cd_size, fp) != cd_size) {
+        free(cd);
+        fclose(fp);
+        printf("ERROR: Не удалось прочитать центральный каталог\n");
+        exit(1);
+    }
+    int res = print_central_directory((span) {cd, cd_size}, count);
+    free(cd);
 
     fclose(fp);
 
-    return 0;
+    return res == 0 ? 0 : 1;
 }
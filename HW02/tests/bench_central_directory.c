@@ -0,0 +1,111 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../central_directory.h"
+
+#define ENTRIES 65535 // максимум записей без zip64: кол-во в eocdr - uint16_t
+#define RUNS 15
+#define NAME_MAX_LEN 32
+
+/**
+ * Центральный каталог из ENTRIES записей с именами dir/fileNNNNN.txt
+ * @param len - размер каталога
+ * @return каталог, память освобождается free
+ */
+static unsigned char *make_directory(size_t *len) {
+    unsigned char *cd = calloc(ENTRIES, CFH_FIXED_SIZE + NAME_MAX_LEN);
+    if (cd == NULL) {
+        printf("ERROR: Не удалось выделить память.\n");
+        exit(1);
+    }
+
+    size_t pos = 0;
+    for (unsigned i = 0; i < ENTRIES; ++i) {
+        unsigned char *h = cd + pos;
+        char name[NAME_MAX_LEN];
+        int name_len = snprintf(name, sizeof(name), "dir/file%05u.txt", i);
+        h[0] = 0x50;
+        h[1] = 0x4b;
+        h[2] = 0x01;
+        h[3] = 0x02;
+        h[28] = (unsigned char) name_len;
+        memcpy(h + CFH_FIXED_SIZE, name, (size_t) name_len);
+        pos += CFH_FIXED_SIZE + (size_t) name_len;
+    }
+    *len = pos;
+    return cd;
+}
+
+/**
+ * Тот же обход без проверок границ - точка отсчета для оценки их стоимости
+ */
+static int print_central_directory_unchecked(span cd, uint16_t count) {
+    size_t pos = 0;
+    for (uint16_t i = 0; i < count; ++i) {
+        if (read_u32(cd.data + pos) != CFH_SIGNATURE) {
+            printf("ERROR: не найдена сигнатура центрального каталога\n");
+            return -1;
+        }
+        size_t name_len = read_u16(cd.data + pos + 28);
+        size_t var_len = name_len + read_u16(cd.data + pos + 30) + read_u16(cd.data + pos + 32);
+        pos += CFH_FIXED_SIZE;
+        printf("%.*s\n", (int) name_len, (const char *) cd.data + pos);
+        pos += var_len;
+    }
+    return 0;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/**
+ * Замер стоимости проверок границ разбора центрального каталога: лучшее время из RUNS обходов
+ * с проверками и без. Вывод имен уходит в /dev/null.
+ * main [кол-во прогонов]
+ * @return 0|1 - 0 оба обхода разобрали каталог | 1 ошибка
+ */
+int main(int argc, char *argv[]) {
+    int runs = argc > 1 ? atoi(argv[1]) : RUNS;
+    size_t len;
+    unsigned char *cd = make_directory(&len);
+    span s = {cd, len};
+    double best_checked = 1e30, best_unchecked = 1e30;
+    int res = 0;
+
+    FILE *report = fdopen(dup(fileno(stdout)), "w");
+    if (report == NULL || freopen("/dev/null", "w", stdout) == NULL) {
+        fprintf(stderr, "ERROR: Не удалось перенаправить вывод.\n");
+        return 1;
+    }
+
+    for (int r = 0; r < runs; ++r) {
+        double start = now();
+        res |= print_central_directory_unchecked(s, ENTRIES);
+        fflush(stdout);
+        double unchecked = now() - start;
+
+        start = now();
+        res |= print_central_directory(s, ENTRIES);
+        fflush(stdout);
+        double checked = now() - start;
+
+        best_unchecked = unchecked < best_unchecked ? unchecked : best_unchecked;
+        best_checked = checked < best_checked ? checked : best_checked;
+    }
+
+    fprintf(report, "Записей: %d, размер каталога: %zu байт\n", ENTRIES, len);
+    fprintf(report, "Без проверок: %.3f мс\n", best_unchecked * 1e3);
+    fprintf(report, "С проверками: %.3f мс\n", best_checked * 1e3);
+    fprintf(report, "Стоимость проверок: %+.2f%%\n", (best_checked / best_unchecked - 1) * 100);
+    fclose(report);
+    free(cd);
+
+    return res != 0;
+}
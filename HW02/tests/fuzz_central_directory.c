@@ -0,0 +1,45 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "../central_directory.h"
+
+/**
+ * Вывод разобранных имен не нужен, он только замедляет фаззинг
+ */
+int LLVMFuzzerInitialize(int *argc, char ***argv) {
+    (void) argc;
+    (void) argv;
+    if (freopen("/dev/null", "w", stdout) == NULL) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Первый байт выбирает режим:
+ * 0 - остаток данных разбирается как хвост файла (поиск eocdr, проверка и центральный каталог из хвоста,
+ *     как в пакетном режиме);
+ * 1 - два байта кол-ва записей, затем центральный каталог
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    if (size < 3) {
+        return 0;
+    }
+
+    if (data[0] & 1) {
+        print_central_directory((span) {data + 3, size - 3}, read_u16(data + 1));
+        return 0;
+    }
+
+    span tail = {data + 1, size - 1};
+    size_t pos;
+    if (!find_eocdr_in(tail, &pos)) {
+        return 0;
+    }
+    uint16_t count = read_u16(tail.data + pos + 10);
+    uint32_t cd_size = read_u32(tail.data + pos + 12);
+    if (eocdr_valid(pos, cd_size, count)) {
+        print_central_directory((span) {tail.data + pos - cd_size, cd_size}, count);
+    }
+    return 0;
+}
@@ -0,0 +1,222 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "history.h"
+
+#define HISTORY_PATH_MAX (HISTORY_DIR_MAX + 32)
+#define BACKOFF_MS 500 // задержка перед первым повтором, далее удваивается
+#define BACKOFF_MAX_MS 30000
+
+/**
+ * Загрузка одного дня: состояние запроса http_get_many
+ */
+typedef struct {
+    history *hist;
+    long day; // загружаемый день
+    int attempt; // кол-во выполненных повторов
+    int io_error; // 1 - не удалось записать файл
+    FILE *fp; // временный файл ответа
+    char path[HISTORY_PATH_MAX]; // файл результата
+    char tmp[HISTORY_PATH_MAX + 8]; // временный файл, переименовывается в path после загрузки
+} history_slot;
+
+/**
+ * Кол-во дней от 1970-01-01 до даты по григорианскому календарю
+ */
+static long days_from_civil(long y, int m, int d) {
+    y -= m <= 2;
+    long era = (y >= 0 ? y : y - 399) / 400;
+    long yoe = y - era * 400;
+    long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+/**
+ * Дата по кол-ву дней от 1970-01-01
+ */
+static void civil_from_days(long z, int *y, int *m, int *d) {
+    z += 719468;
+    long era = (z >= 0 ? z : z - 146096) / 146097;
+    long doe = z - era * 146097;
+    long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long mp = (5 * doy + 2) / 153;
+    *d = (int) (doy - (153 * mp + 2) / 5 + 1);
+    *m = (int) (mp < 10 ? mp + 3 : mp - 9);
+    *y = (int) (yoe + era * 400 + (*m <= 2));
+}
+
+/**
+ * Разбор даты
+ * @param date - дата в формате yyyy-mm-dd
+ * @param day - результат, дней от 1970-01-01
+ * @return 0|1 - 0 дата разобрана | 1 некорректная дата
+ */
+int history_date(const char *date, long *day) {
+    int y, m, d, cy, cm, cd;
+    char tail;
+    if (sscanf(date, "%4d-%2d-%2d%c", &y, &m, &d, &tail) != 3 || m < 1 || m > 12 || d < 1 || d > 31) {
+        return 1;
+    }
+
+    /** несуществующая дата (например, 02-30) после пересчета не совпадает с исходной */
+    *day = days_from_civil(y, m, d);
+    civil_from_days(*day, &cy, &cm, &cd);
+
+    return cy != y || cm != m || cd != d;
+}
+
+/**
+ * Переход к следующему дню, файла которого еще нет: открывает временный файл и задает url запроса
+ * @param slot - состояние загрузки
+ * @param request - запрос
+ * @return 1|0 - 1 задан запрос следующего дня | 0 дни диапазона закончились
+ */
+static int history_next(history_slot *slot, http_request *request) {
+    history *hist = slot->hist;
+    while (hist->next <= hist->to) {
+        int y, m, d;
+        slot->day = hist->next++;
+        civil_from_days(slot->day, &y, &m, &d);
+        snprintf(slot->path, sizeof(slot->path), "%s/%04d-%02d-%02d.json", hist->dir, y, m, d);
+        if (access(slot->path, F_OK) == 0) {
+            hist->skipped++;
+            continue;
+        }
+
+        snprintf(slot->tmp, sizeof(slot->tmp), "%s.part", slot->path);
+        if ((slot->fp = fopen(slot->tmp, "wb")) == NULL) {
+            fprintf(stderr, "ERROR: Не удалось создать файл %s\n", slot->tmp);
+            hist->failed++;
+            continue;
+        }
+        slot->attempt = 0;
+        slot->io_error = 0;
+        int len = snprintf(request->url, URL_MAX, "%s", hist->url);
+        snprintf(request->url + len, URL_MAX - (size_t) len, "%04d/%02d/%02d/", y, m, d);
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * Запись порции ответа во временный файл дня по мере получения
+ */
+static int history_data(const char *data, size_t len, void *userp) {
+    history_slot *slot = userp;
+    if (fwrite(data, 1, len, slot->fp) != len) {
+        slot->io_error = 1;
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * Обработчик завершения запроса дня: сохраняет файл, при ошибке сети или сервера повторяет запрос
+ * с экспоненциальной задержкой, затем задает запрос следующего дня
+ * @param request - завершенный запрос
+ * @param code - код ошибки curl
+ * @return 1|0 - 1 задан следующий запрос | 0 дни диапазона закончились
+ */
+static int history_done(http_request *request, int code) {
+    history_slot *slot = request->userp;
+    history *hist = slot->hist;
+    long status = request->status;
+
+    if (code == 0 && !slot->io_error && (status == 0 || status == 200 || status == 304)) {
+        int closed = fclose(slot->fp);
+        slot->fp = NULL;
+        if (closed == 0 && rename(slot->tmp, slot->path) == 0) {
+            hist->loaded++;
+        } else {
+            fprintf(stderr, "ERROR: Не удалось сохранить файл %s\n", slot->path);
+            remove(slot->tmp);
+            hist->failed++;
+        }
+        return history_next(slot, request);
+    }
+
+    /** повторяем запрос при ошибке сети, перегрузке или ошибке сервера */
+    int retry = !slot->io_error && (code != 0 || status == 429 || status >= 500);
+    if (retry && slot->attempt < hist->retries && (slot->fp = freopen(slot->tmp, "wb", slot->fp)) != NULL) {
+        long delay = (long) BACKOFF_MS << slot->attempt;
+        slot->attempt++;
+        request->delay_ms = delay < BACKOFF_MAX_MS ? delay : BACKOFF_MAX_MS;
+        fprintf(stderr, "WARNING: Повтор %d через %ld мс: %s\n", slot->attempt, request->delay_ms, request->url);
+        return 1;
+    }
+
+    fprintf(stderr, "ERROR: Не удалось загрузить %s (код ответа %ld)\n", request->url, status);
+    if (slot->fp) {
+        fclose(slot->fp);
+        slot->fp = NULL;
+    }
+    remove(slot->tmp);
+    hist->failed++;
+
+    return history_next(slot, request);
+}
+
+/**
+ * Загрузка архива погоды за диапазон дат. Одновременно загружается не более max_parallel дней,
+ * каждый запрос по завершении сразу берет следующий день, поэтому память и кол-во открытых файлов
+ * ограничены max_parallel независимо от длины диапазона
+ * @param client - клиент
+ * @param hist - параметры загрузки (url, dir, from, to, retries), результат в loaded, skipped, failed
+ * @param max_parallel - максимальное кол-во одновременных запросов
+ * @return 0|1 - 0 все дни обработаны | 1 ошибка
+ */
+int history_download(http_client *client, history *hist, size_t max_parallel) {
+    if (mkdir(hist->dir, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "ERROR: Не удалось создать каталог %s\n", hist->dir);
+        return 1;
+    }
+    hist->next = hist->from;
+
+    size_t days = hist->to >= hist->from ? (size_t) (hist->to - hist->from + 1) : 0;
+    size_t count = max_parallel < days ? max_parallel : days;
+    http_request *requests = calloc(count ? count : 1, sizeof(http_request));
+    history_slot *slots = calloc(count ? count : 1, sizeof(history_slot));
+    if (!requests || !slots) {
+        fprintf(stderr, "ERROR: Не удалось выделить память.\n");
+        free(requests);
+        free(slots);
+        return 1;
+    }
+
+    size_t started = 0;
+    while (started < count) {
+        slots[started].hist = hist;
+        if (!history_next(&slots[started], &requests[started])) {
+            break;
+        }
+        requests[started].userp = &slots[started];
+        requests[started].response.on_data = history_data;
+        requests[started].response.on_data_userp = &slots[started];
+        // без кэша ответов тело хранится только в файле
+        requests[started].response.discard = client->cache == NULL;
+        started++;
+    }
+
+    int res = http_get_many(client, requests, started, started, history_done);
+
+    for (size_t i = 0; i < started; ++i) {
+        if (slots[i].fp) {
+            fclose(slots[i].fp);
+            remove(slots[i].tmp);
+        }
+        http_buffer_free(&requests[i].response);
+    }
+    free(requests);
+    free(slots);
+
+    return res || hist->failed > 0;
+}
@@ -0,0 +1,30 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stddef.h>
+#include "http.h"
+
+#define HISTORY_DIR_MAX 512
+#define HISTORY_RETRIES 3 // кол-во повторов запроса дня по умолчанию
+
+/**
+ * Загрузка архива погоды локации за диапазон дат (/location/<woeid>/<yyyy>/<mm>/<dd>/).
+ * Ответ каждого дня по мере получения пишется в файл <dir>/<yyyy>-<mm>-<dd>.json,
+ * поэтому память не зависит от длины диапазона. Уже загруженные дни пропускаются
+ */
+typedef struct {
+    char url[URL_MAX]; // url данных локации, к нему добавляется дата
+    char dir[HISTORY_DIR_MAX]; // каталог файлов результата
+    long from; // первый день диапазона (дней от 1970-01-01)
+    long to; // последний день диапазона
+    int retries; // кол-во повторов запроса дня после ошибки
+    long next; // следующий день для загрузки
+    size_t loaded; // загружено дней
+    size_t skipped; // пропущено дней, файл которых уже есть
+    size_t failed; // дней, которые не удалось загрузить
+} history;
+
+int history_date(const char *date, long *day);
+int history_download(http_client *client, history *hist, size_t max_parallel);
+
+#endif
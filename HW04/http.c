@@ -0,0 +1,679 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include "http.h"
+#include "response_cache.h"
+
+#define BUF_MIN_CAP 4096
+#define PRESIZE_MAX (16 * 1024 * 1024) // больше по Content-Length заранее не выделяем, буфер растет по мере получения
+#define POLL_TIMEOUT_MS 1000
+#define CONNECT_TIMEOUT_S 10 // ожидание соединения с сервером
+#define REQUEST_TIMEOUT_S 60 // предельное время запроса целиком
+#define LOW_SPEED_LIMIT 1 // запрос медленнее 1 байт/с ...
+#define LOW_SPEED_TIME_S 15 // ... дольше 15 с считается зависшим
+
+/**
+ * Запрос http_get_many, отложенный до истечения задержки
+ */
+typedef struct {
+    http_request *request;
+    long start_at; // время запуска, мс
+} http_delayed;
+
+/**
+ * Состояние http_get_many. Запрос находится не более чем в одном из списков: выполняется (inflight),
+ * ждет завершения выполняемого запроса с тем же url (waiting ведущего), ждет свободного handle (ready)
+ * или ждет истечения задержки (delayed)
+ */
+typedef struct {
+    http_client *client;
+    CURLM *multi;
+    http_done_fn on_done;
+    CURL **pool; // свободные handle
+    size_t free_handles;
+    http_request **inflight; // выполняемые запросы
+    size_t inflight_count;
+    http_request **ready; // запросы, ожидающие свободного handle
+    size_t ready_count;
+    http_delayed *delayed; // запросы, ожидающие истечения задержки
+    size_t delayed_count;
+} http_many;
+
+/**
+ * Резервирование памяти буфера под need байт данных и нуль-символ
+ * @param buffer - буфер
+ * @param need - требуемый размер данных
+ * @return 0|1 - 0 память есть | 1 не удалось выделить память
+ */
+int http_buffer_reserve(http_buffer *buffer, size_t need) {
+    if (need < buffer->cap) {
+        return 0;
+    }
+    if (need == SIZE_MAX) {
+        return 1;
+    }
+
+    size_t cap = buffer->cap ? buffer->cap : BUF_MIN_CAP;
+    while (cap <= need) {
+        // удвоение переполнится - выделяем ровно под need
+        if (cap > SIZE_MAX / 2) {
+            cap = need + 1;
+            break;
+        }
+        cap *= 2;
+    }
+    char *data = realloc(buffer->data, cap);
+    if (data == NULL) {
+        return 1;
+    }
+    buffer->data = data;
+    buffer->cap = cap;
+
+    return 0;
+}
+
+/**
+ * Освобождение памяти буфера
+ * @param buffer - буфер
+ */
+void http_buffer_free(http_buffer *buffer) {
+    free(buffer->data);
+    memset(buffer, 0, sizeof(http_buffer));
+}
+
+/**
+ * Запись полученных запросом curl данных в буфер ответа
+ * @param buffer - полученные данные
+ * @param size
+ * @param nmemb
+ * @param userp - буфер ответа http_buffer
+ * @return 0|<size_t> - 0 не удалось произвести действия | <size_t> размер прочитанного в байтах
+ */
+static size_t write_data(void *buffer, size_t size, size_t nmemb, void *userp) {
+    http_buffer *response = userp;
+
+    /** Определяем размер полученных данных */
+    size_t segsize = size * nmemb;
+
+    /** Передаем данные обработчику сразу по получении */
+    if (response->on_data && response->on_data(buffer, segsize, response->on_data_userp)) {
+        return 0;
+    }
+    if (response->discard) {
+        return segsize;
+    }
+
+    if (http_buffer_reserve(response, response->len + segsize)) {
+        fprintf(stderr, "ERROR: Не удалось выделить память под ответ\n");
+        return 0;
+    }
+
+    /** Записываем полученные данные в буфер */
+    memcpy(response->data + response->len, buffer, segsize);
+    response->len += segsize;
+
+    /* Последним в конец строки символ конца строки */
+    response->data[response->len] = '\0';
+
+    /* Возвращаем кол-во полученных байт */
+    return segsize;
+}
+
+/**
+ * Значение заголовка, если строка заголовка относится к нему
+ * @param header - строка заголовка (без нуль-символа)
+ * @param len - длина строки заголовка
+ * @param name - название заголовка с двоеточием в нижнем регистре
+ * @param value - буфер значения без пробелов по краям
+ * @param size - размер буфера значения
+ * @return 1|0 - 1 значение получено | 0 строка другого заголовка
+ */
+static int header_value(const char *header, size_t len, const char *name, char *value, size_t size) {
+    size_t name_len = strlen(name);
+    if (len < name_len || strncasecmp(header, name, name_len) != 0) {
+        return 0;
+    }
+
+    const char *begin = header + name_len, *end = header + len;
+    while (begin < end && (*begin == ' ' || *begin == '\t')) {
+        begin++;
+    }
+    while (end > begin && (end[-1] == '\r' || end[-1] == '\n' || end[-1] == ' ' || end[-1] == '\t')) {
+        end--;
+    }
+    size_t value_len = (size_t) (end - begin) < size ? (size_t) (end - begin) : size - 1;
+    memcpy(value, begin, value_len);
+    value[value_len] = '\0';
+
+    return 1;
+}
+
+/**
+ * Обработка заголовков ответа: по Content-Length заранее выделяем память под весь ответ,
+ * если он не больше PRESIZE_MAX (заголовок приходит от сервера и доверять ему нельзя),
+ * ETag и Last-Modified запоминаем для кэша ответов
+ * @param header - строка заголовка (без нуль-символа)
+ * @param size
+ * @param nitems
+ * @param userp - буфер ответа http_buffer
+ * @return <size_t> - размер обработанного заголовка
+ */
+static size_t header_data(char *header, size_t size, size_t nitems, void *userp) {
+    http_buffer *response = userp;
+    size_t len = size * nitems;
+    char value[32];
+
+    if (header_value(header, len, "content-length:", value, sizeof(value))) {
+        unsigned long long content_length = strtoull(value, NULL, 10);
+        if (content_length > 0 && content_length <= PRESIZE_MAX) {
+            // ошибку выделения не обрабатываем: при записи данных буфер будет расти обычным образом
+            http_buffer_reserve(response, response->len + (size_t) content_length);
+        }
+    } else if (!header_value(header, len, "etag:", response->etag, HTTP_VALIDATOR_MAX)) {
+        header_value(header, len, "last-modified:", response->last_modified, HTTP_VALIDATOR_MAX);
+    }
+
+    return len;
+}
+
+/**
+ * Очистка буфера ответа перед запросом с сохранением выделенной памяти
+ * @param response - буфер ответа
+ * @return 0|1 - 0 буфер готов | 1 не удалось выделить память
+ */
+static int http_buffer_clear(http_buffer *response) {
+    response->len = 0;
+    response->etag[0] = '\0';
+    response->last_modified[0] = '\0';
+    if (http_buffer_reserve(response, 0)) {
+        fprintf(stderr, "ERROR: Не удалось выделить память под ответ\n");
+        return 1;
+    }
+    response->data[0] = '\0';
+
+    return 0;
+}
+
+/**
+ * Чтение ответа из кэша в буфер ответа с передачей обработчику данных, если он задан
+ * @param client - клиент
+ * @param url - url запроса
+ * @param response - буфер ответа
+ * @return 1|0 - 1 ответ прочитан | 0 ответа нет в кэше
+ */
+static int http_cache_serve(http_client *client, const char *url, http_buffer *response) {
+    if (!response_cache_read(client->cache, url, response)) {
+        return 0;
+    }
+    if (response->on_data) {
+        response->on_data(response->data, response->len, response->on_data_userp);
+    }
+
+    return 1;
+}
+
+/**
+ * Проверка кэша ответов перед запросом. Актуальный ответ берется из кэша,
+ * для устаревшего задаются заголовки условного запроса по его ETag и Last-Modified
+ * @param client - клиент
+ * @param handle - easy handle запроса
+ * @param url - url запроса
+ * @param response - буфер ответа
+ * @param headers - заголовки условного запроса, освобождаются вызывающим кодом
+ * @return 1|0 - 1 ответ получен из кэша | 0 запрос нужно выполнить
+ */
+static int http_cache_before(http_client *client, CURL *handle, const char *url, http_buffer *response,
+                             struct curl_slist **headers) {
+    curl_easy_setopt(handle, CURLOPT_HTTPHEADER, NULL);
+    response_cache_meta meta;
+    if (client->cache == NULL || !response_cache_meta_get(client->cache, url, &meta)) {
+        return 0;
+    }
+    if (time(NULL) - meta.fetched < client->cache->ttl && http_cache_serve(client, url, response)) {
+        return 1;
+    }
+
+    char line[HTTP_VALIDATOR_MAX + 32];
+    if (meta.etag[0]) {
+        snprintf(line, sizeof(line), "If-None-Match: %s", meta.etag);
+        *headers = curl_slist_append(*headers, line);
+    }
+    if (meta.last_modified[0]) {
+        snprintf(line, sizeof(line), "If-Modified-Since: %s", meta.last_modified);
+        *headers = curl_slist_append(*headers, line);
+    }
+    curl_easy_setopt(handle, CURLOPT_HTTPHEADER, *headers);
+
+    return 0;
+}
+
+/**
+ * Обработка ответа с учетом кэша: при 304 тело ответа берется из кэша, ответ 200 сохраняется в кэш
+ * @param client - клиент
+ * @param handle - easy handle запроса
+ * @param url - url запроса
+ * @param response - буфер ответа
+ * @param code - код завершения запроса curl
+ * @return 0|<code> - 0 ответ получен | <code> код ошибки
+ */
+static int http_cache_after(http_client *client, CURL *handle, const char *url, http_buffer *response, int code) {
+    if (client->cache == NULL || code != CURLE_OK) {
+        return code;
+    }
+
+    long status = 0;
+    curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &status);
+    if (status == 304) {
+        if (!http_cache_serve(client, url, response)) {
+            fprintf(stderr, "ERROR: Не удалось прочитать ответ из кэша: %s\n", url);
+            return CURLE_READ_ERROR;
+        }
+        response_cache_touch(client->cache, url);
+    } else if (status == 200) {
+        response_cache_store(client->cache, url, response);
+    }
+
+    return CURLE_OK;
+}
+
+/**
+ * Инициализация клиента: глобальная инициализация curl, общие кэши и easy handle с постоянными опциями
+ * @param client - инициализируемый клиент
+ * @return 0|1 - 0 клиент готов | 1 не удалось инициализировать curl
+ */
+int http_client_init(http_client *client) {
+    memset(client, 0, sizeof(http_client));
+
+    if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
+        fprintf(stderr, "ERROR: Не удалось инициализировать curl.\n");
+        return 1;
+    }
+
+    client->share = curl_share_init();
+    client->handle = curl_easy_init();
+    if (!client->share || !client->handle) {
+        fprintf(stderr, "ERROR: Не удалось инициализировать curl.\n");
+        http_client_cleanup(client);
+        return 1;
+    }
+    client->single_flight = 1;
+    curl_share_setopt(client->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(client->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    curl_share_setopt(client->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+
+    /** устанавливаем опции curl, общие для всех запросов клиента */
+    curl_easy_setopt(client->handle, CURLOPT_SHARE, client->share);
+    curl_easy_setopt(client->handle, CURLOPT_SSL_VERIFYPEER, 0L); // не проверяем ssl
+    curl_easy_setopt(client->handle, CURLOPT_TCP_KEEPALIVE, 1L); // поддерживаем соединение между запросами
+    curl_easy_setopt(client->handle, CURLOPT_HTTP_VERSION, (long) CURL_HTTP_VERSION_2TLS); // http/2, если сервер поддерживает
+    curl_easy_setopt(client->handle, CURLOPT_ACCEPT_ENCODING, ""); // сжатие ответа, которое поддерживает libcurl
+    curl_easy_setopt(client->handle, CURLOPT_WRITEFUNCTION, write_data); // Указываем в какую функцию передать результат
+    curl_easy_setopt(client->handle, CURLOPT_HEADERFUNCTION, header_data); // по заголовкам заранее выделяем память
+    /** зависший сервер не должен держать запрос вечно, curl_easy_duphandle переносит таймауты во все запросы */
+    curl_easy_setopt(client->handle, CURLOPT_CONNECTTIMEOUT, (long) CONNECT_TIMEOUT_S);
+    curl_easy_setopt(client->handle, CURLOPT_TIMEOUT, (long) REQUEST_TIMEOUT_S);
+    curl_easy_setopt(client->handle, CURLOPT_LOW_SPEED_LIMIT, (long) LOW_SPEED_LIMIT);
+    curl_easy_setopt(client->handle, CURLOPT_LOW_SPEED_TIME, (long) LOW_SPEED_TIME_S);
+
+    return 0;
+}
+
+/**
+ * Освобождение клиента и глобальных ресурсов curl
+ * @param client - клиент
+ */
+void http_client_cleanup(http_client *client) {
+    if (client->handle) {
+        curl_easy_cleanup(client->handle);
+    }
+    if (client->share) {
+        curl_share_cleanup(client->share);
+    }
+    memset(client, 0, sizeof(http_client));
+    curl_global_cleanup();
+}
+
+/**
+ * Выполнение запроса GET через клиент
+ * @param client - клиент
+ * @param url - url которому обращаемся
+ * @param response - буфер ответа. Память буфера переиспользуется между запросами, освобождается http_buffer_free.
+ *                   Если задан response->on_data, данные передаются ему по мере получения
+ * @return 0|<code> - 0 запрос прошел успешно | <code> код ошибки
+ */
+int http_get(http_client *client, const char *url, http_buffer *response) {
+    CURLcode res;
+    if (http_buffer_clear(response)) {
+        return CURLE_OUT_OF_MEMORY;
+    }
+    // без кэша ответов тело, переданное обработчику, хранить незачем
+    response->discard = response->on_data != NULL && client->cache == NULL;
+
+    /** актуальный ответ из кэша отдаем без обращения к серверу */
+    struct curl_slist *headers = NULL;
+    if (http_cache_before(client, client->handle, url, response, &headers)) {
+        return 0;
+    }
+
+    curl_easy_setopt(client->handle, CURLOPT_URL, url); // url обращения
+    curl_easy_setopt(client->handle, CURLOPT_WRITEDATA, response);
+    curl_easy_setopt(client->handle, CURLOPT_HEADERDATA, response);
+
+    /** непосредственно запрос curl */
+    res = curl_easy_perform(client->handle);
+    res = http_cache_after(client, client->handle, url, response, res);
+    curl_easy_setopt(client->handle, CURLOPT_HTTPHEADER, NULL);
+    curl_slist_free_all(headers);
+
+    /* Проверка на ошибки */
+    if (res != CURLE_OK) {
+        fprintf(stderr, "ERROR code=(%d): curl_easy_perform() failed: %s\n", res, curl_easy_strerror(res));
+        return res;
+    }
+
+    return 0;
+}
+
+/**
+ * Монотонное время в миллисекундах для отложенных запросов
+ */
+static long http_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
+
+/**
+ * Выполняемый запрос с тем же url, к ответу которого можно присоединиться.
+ * Ответ, который только передается обработчику и не сохраняется в буфере, разделить нельзя
+ * @param many - состояние http_get_many
+ * @param url - url запроса
+ * @return NULL|<http_request*> - NULL такого запроса нет | выполняемый запрос
+ */
+static http_request *http_many_inflight(http_many *many, const char *url) {
+    if (!many->client->single_flight) {
+        return NULL;
+    }
+    for (size_t i = 0; i < many->inflight_count; ++i) {
+        if (!many->inflight[i]->response.discard && strcmp(many->inflight[i]->url, url) == 0) {
+            return many->inflight[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Передача результата запроса обработчику. Заданный обработчиком следующий запрос
+ * ставится в очередь на свободный handle или, при задержке, в отложенные
+ * @param many - состояние http_get_many
+ * @param request - завершенный запрос
+ * @param code - код ошибки curl
+ */
+static void http_many_done(http_many *many, http_request *request, int code) {
+    request->delay_ms = 0;
+    if (!many->on_done(request, code)) {
+        return;
+    }
+    if (request->delay_ms > 0) {
+        many->delayed[many->delayed_count++] = (http_delayed) {request, http_now_ms() + request->delay_ms};
+    } else {
+        many->ready[many->ready_count++] = request;
+    }
+}
+
+/**
+ * Копирование ответа ведущего запроса в запрос, ожидавший его (single-flight)
+ * @param follower - ожидавший запрос
+ * @param leader - выполненный запрос с тем же url
+ * @return 0|<code> - 0 ответ скопирован | CURLE_OUT_OF_MEMORY
+ */
+static int http_many_share(http_request *follower, const http_request *leader) {
+    const http_buffer *from = &leader->response;
+    http_buffer *to = &follower->response;
+    follower->status = leader->status;
+    follower->total_time = leader->total_time;
+    memcpy(to->etag, from->etag, HTTP_VALIDATOR_MAX);
+    memcpy(to->last_modified, from->last_modified, HTTP_VALIDATOR_MAX);
+    if (to->on_data && to->on_data(from->data, from->len, to->on_data_userp)) {
+        return CURLE_WRITE_ERROR;
+    }
+    if (to->discard) {
+        return CURLE_OK;
+    }
+    if (http_buffer_reserve(to, from->len)) {
+        fprintf(stderr, "ERROR: Не удалось выделить память под ответ\n");
+        return CURLE_OUT_OF_MEMORY;
+    }
+    memcpy(to->data, from->data, from->len + 1);
+    to->len = from->len;
+
+    return CURLE_OK;
+}
+
+/**
+ * Запуск запроса из http_get_many. Если тот же url уже выполняется, запрос ждет его ответа
+ * без отдельного обращения к серверу. Если ответ актуален в кэше, запрос завершается сразу,
+ * и заданный обработчиком следующий запрос проверяется так же
+ * @param many - состояние http_get_many
+ * @param handle - свободный easy handle
+ * @param request - запрос
+ * @return 1|0 - 1 handle добавлен в multi | 0 handle не занят
+ */
+static int http_many_start(http_many *many, CURL *handle, http_request *request) {
+    for (;;) {
+        request->status = 0;
+        request->total_time = 0;
+        request->delay_ms = 0;
+        if (http_buffer_clear(&request->response)) {
+            http_many_done(many, request, CURLE_OUT_OF_MEMORY);
+            return 0;
+        }
+
+        http_request *leader = http_many_inflight(many, request->url);
+        if (leader != NULL) {
+            request->waiting = leader->waiting;
+            leader->waiting = request;
+            return 0;
+        }
+
+        if (!http_cache_before(many->client, handle, request->url, &request->response, &request->headers)) {
+            break;
+        }
+        if (!many->on_done(request, CURLE_OK)) {
+            return 0;
+        }
+        if (request->delay_ms > 0) {
+            many->delayed[many->delayed_count++] = (http_delayed) {request, http_now_ms() + request->delay_ms};
+            return 0;
+        }
+    }
+
+    curl_easy_setopt(handle, CURLOPT_URL, request->url);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, &request->response);
+    curl_easy_setopt(handle, CURLOPT_HEADERDATA, &request->response);
+    curl_easy_setopt(handle, CURLOPT_PRIVATE, request);
+    curl_multi_add_handle(many->multi, handle);
+    many->inflight[many->inflight_count++] = request;
+
+    return 1;
+}
+
+/**
+ * Обработка завершенного запроса: ответ учитывается в кэше, копируется запросам, ожидавшим тот же url,
+ * затем передается обработчикам всех этих запросов
+ * @param many - состояние http_get_many
+ * @param handle - easy handle запроса
+ * @param code - код завершения запроса curl
+ */
+static void http_many_complete(http_many *many, CURL *handle, int code) {
+    http_request *request;
+    curl_easy_getinfo(handle, CURLINFO_PRIVATE, (char **) &request);
+    curl_multi_remove_handle(many->multi, handle);
+    curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &request->status);
+    curl_easy_getinfo(handle, CURLINFO_TOTAL_TIME, &request->total_time);
+    code = http_cache_after(many->client, handle, request->url, &request->response, code);
+    curl_easy_setopt(handle, CURLOPT_HTTPHEADER, NULL);
+    curl_slist_free_all(request->headers);
+    request->headers = NULL;
+    many->pool[many->free_handles++] = handle;
+    for (size_t i = 0; i < many->inflight_count; ++i) {
+        if (many->inflight[i] == request) {
+            many->inflight[i] = many->inflight[--many->inflight_count];
+            break;
+        }
+    }
+    if (code != CURLE_OK) {
+        fprintf(stderr, "ERROR code=(%d): %s: %s\n", code, request->url, curl_easy_strerror(code));
+    }
+
+    http_request *follower = request->waiting;
+    request->waiting = NULL;
+    while (follower != NULL) {
+        http_request *next = follower->waiting;
+        follower->waiting = NULL;
+        http_many_done(many, follower, code != CURLE_OK ? code : http_many_share(follower, request));
+        follower = next;
+    }
+    http_many_done(many, request, code);
+}
+
+/**
+ * Одновременное выполнение запросов через curl multi в одном цикле событий.
+ * По завершении каждого запроса вызывается on_done, который может задать следующий запрос
+ * (например, получение погоды после поиска локации) - он выполняется без ожидания остальных.
+ * Следующий запрос с задержкой (повтор после ошибки) ждет своего времени, не блокируя остальные запросы.
+ * Запросы с одинаковым url, выполняемые одновременно, объединяются: к серверу уходит один запрос,
+ * его ответ копируется всем ожидавшим (single-flight).
+ * Handle копируют опции клиента и используют его общие кэши DNS, TLS и соединений, а также кэш ответов
+ * @param client - клиент
+ * @param requests - массив запросов
+ * @param count - кол-во запросов
+ * @param max_parallel - максимальное кол-во одновременно выполняемых запросов
+ * @param on_done - обработчик завершения запроса
+ * @return 0|1 - 0 все запросы обработаны | 1 ошибка curl multi
+ */
+int http_get_many(http_client *client, http_request *requests, size_t count, size_t max_parallel,
+                  http_done_fn on_done) {
+    if (max_parallel == 0) {
+        max_parallel = 1;
+    }
+    if (max_parallel > count) {
+        max_parallel = count;
+    }
+
+    http_many many = {0};
+    many.client = client;
+    many.on_done = on_done;
+    many.multi = curl_multi_init();
+    CURL **handles = calloc(max_parallel ? max_parallel : 1, sizeof(CURL *)); // все созданные handle
+    many.pool = calloc(max_parallel ? max_parallel : 1, sizeof(CURL *));
+    many.inflight = calloc(max_parallel ? max_parallel : 1, sizeof(http_request *));
+    many.ready = calloc(count ? count : 1, sizeof(http_request *));
+    many.delayed = calloc(count ? count : 1, sizeof(http_delayed));
+    if (!many.multi || !handles || !many.pool || !many.inflight || !many.ready || !many.delayed) {
+        fprintf(stderr, "ERROR: Не удалось инициализировать curl multi.\n");
+        curl_multi_cleanup(many.multi);
+        free(handles);
+        free(many.pool);
+        free(many.inflight);
+        free(many.ready);
+        free(many.delayed);
+        return 1;
+    }
+    curl_multi_setopt(many.multi, CURLMOPT_PIPELINING, (long) CURLPIPE_MULTIPLEX); // несколько запросов в одном соединении http/2
+
+    size_t handles_count = 0;
+    for (size_t i = 0; i < max_parallel; ++i) {
+        if ((handles[handles_count] = curl_easy_duphandle(client->handle)) != NULL) {
+            curl_easy_setopt(handles[handles_count], CURLOPT_FRESH_CONNECT, (long) client->fresh_connect);
+            curl_easy_setopt(handles[handles_count], CURLOPT_FORBID_REUSE, (long) client->fresh_connect);
+            many.pool[handles_count] = handles[handles_count];
+            handles_count++;
+        }
+    }
+    many.free_handles = handles_count;
+
+    int result = 0;
+    if (handles_count == 0 && count > 0) {
+        fprintf(stderr, "ERROR: Не удалось инициализировать curl.\n");
+        result = 1;
+    }
+
+    size_t next = 0; // следующий запрос для запуска
+    int running = 0;
+    while (result == 0 && (many.inflight_count > 0 || next < count || many.ready_count > 0 || many.delayed_count > 0)) {
+        /** отложенные запросы, время которых наступило, ставим в очередь на запуск */
+        long now = http_now_ms();
+        for (size_t i = 0; i < many.delayed_count;) {
+            if (many.delayed[i].start_at > now) {
+                i++;
+                continue;
+            }
+            many.ready[many.ready_count++] = many.delayed[i].request;
+            many.delayed[i] = many.delayed[--many.delayed_count];
+        }
+
+        /** запускаем запросы, пока есть свободные handle: сначала следующие запросы обработчиков, затем новые */
+        while (many.free_handles > 0 && (many.ready_count > 0 || next < count)) {
+            http_request *request = many.ready_count > 0 ? many.ready[--many.ready_count] : &requests[next++];
+            CURL *handle = many.pool[--many.free_handles];
+            if (!http_many_start(&many, handle, request)) {
+                many.pool[many.free_handles++] = handle;
+            }
+        }
+
+        if (curl_multi_perform(many.multi, &running) != CURLM_OK) {
+            fprintf(stderr, "ERROR: Ошибка curl multi.\n");
+            result = 1;
+            break;
+        }
+
+        /** обрабатываем завершенные запросы */
+        CURLMsg *msg;
+        int left;
+        while ((msg = curl_multi_info_read(many.multi, &left)) != NULL) {
+            if (msg->msg == CURLMSG_DONE) {
+                http_many_complete(&many, msg->easy_handle, msg->data.result);
+            }
+        }
+
+        /** ждем событий curl, но не дольше, чем до запуска ближайшего отложенного запроса */
+        if (many.ready_count > 0 && many.free_handles > 0) {
+            continue;
+        }
+        if (many.inflight_count > 0 || many.delayed_count > 0) {
+            long timeout = POLL_TIMEOUT_MS;
+            now = http_now_ms();
+            for (size_t i = 0; i < many.delayed_count; ++i) {
+                long left_ms = many.delayed[i].start_at - now;
+                if (left_ms < timeout) {
+                    timeout = left_ms > 0 ? left_ms : 0;
+                }
+            }
+            curl_multi_poll(many.multi, NULL, 0, (int) timeout, NULL);
+        }
+    }
+
+    for (size_t i = 0; i < many.inflight_count; ++i) {
+        curl_slist_free_all(many.inflight[i]->headers);
+        many.inflight[i]->headers = NULL;
+    }
+    for (size_t i = 0; i < handles_count; ++i) {
+        curl_multi_remove_handle(many.multi, handles[i]);
+        curl_easy_cleanup(handles[i]);
+    }
+    curl_multi_cleanup(many.multi);
+    free(handles);
+    free(many.pool);
+    free(many.inflight);
+    free(many.ready);
+    free(many.delayed);
+
+    return result;
+}
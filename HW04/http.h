@@ -0,0 +1,78 @@
+#ifndef HTTP_H
+#define HTTP_H
+
+#include <curl/curl.h>
+
+#define HTTP_VALIDATOR_MAX 128
+
+/**
+ * Обработчик порции данных ответа по мере их получения
+ * @return 0|1 - 0 продолжить | 1 прервать запрос
+ */
+typedef int (*http_data_fn)(const char *data, size_t len, void *userp);
+
+/**
+ * Буфер ответа. Растет геометрически, при наличии заголовка Content-Length
+ * память выделяется сразу под весь ответ. Данные всегда завершаются нуль-символом
+ */
+typedef struct {
+    char *data; // полученные данные
+    size_t len; // размер полученных данных без нуль-символа
+    size_t cap; // размер выделенной памяти
+    char etag[HTTP_VALIDATOR_MAX]; // заголовок ETag ответа
+    char last_modified[HTTP_VALIDATOR_MAX]; // заголовок Last-Modified ответа
+    http_data_fn on_data; // обработчик данных по мере получения, для ответа из кэша вызывается один раз со всем телом
+    void *on_data_userp; // данные обработчика
+    int discard; // 1 - данные только передаются обработчику, в буфере не сохраняются
+} http_buffer;
+
+struct response_cache;
+
+/**
+ * Клиент http. libcurl инициализируется один раз на клиента, easy handle переиспользуется
+ * между запросами, поэтому соединения (keep-alive), кэш DNS и сессии TLS сохраняются
+ */
+typedef struct {
+    CURL *handle; // easy handle, через который выполняются все запросы клиента
+    CURLSH *share; // общие кэши DNS, сессий TLS и соединений
+    struct response_cache *cache; // кэш ответов, NULL - запросы всегда выполняются
+    int single_flight; // 1 - одновременные запросы с одинаковым url в http_get_many объединяются
+    int fresh_connect; // 1 - каждый запрос http_get_many открывает новое соединение (для замеров)
+} http_client;
+
+#define URL_MAX 1024
+
+typedef struct http_request http_request;
+
+/**
+ * Обработчик завершения запроса в http_get_many
+ * @param request - завершенный запрос, ответ в request->response
+ * @param code - 0 запрос прошел успешно | <code> код ошибки curl
+ * @return 1|0 - 1 в request->url записан следующий запрос, его нужно выполнить (через request->delay_ms мс,
+ *               если задержка задана) | 0 обработка запроса завершена
+ */
+typedef int (*http_done_fn)(http_request *request, int code);
+
+/**
+ * Запрос для одновременного выполнения через http_get_many
+ */
+struct http_request {
+    char url[URL_MAX]; // url запроса
+    http_buffer response; // буфер ответа
+    void *userp; // данные вызывающего кода
+    struct curl_slist *headers; // заголовки условного запроса (заполняется http_get_many)
+    long status; // код ответа http, 0 - ответ получен из кэша без запроса (заполняется http_get_many)
+    double total_time; // длительность запроса в секундах, 0 - ответ получен из кэша (заполняется http_get_many)
+    long delay_ms; // задержка запуска следующего запроса, заданного on_done (повтор с backoff)
+    http_request *waiting; // запросы с тем же url, ожидающие ответа этого запроса (заполняется http_get_many)
+};
+
+int http_client_init(http_client *client);
+void http_client_cleanup(http_client *client);
+int http_get(http_client *client, const char *url, http_buffer *response);
+int http_get_many(http_client *client, http_request *requests, size_t count, size_t max_parallel,
+                  http_done_fn on_done);
+int http_buffer_reserve(http_buffer *buffer, size_t need);
+void http_buffer_free(http_buffer *buffer);
+
+#endif
@@ -0,0 +1,137 @@
+#include <stdlib.h>
+#include <string.h>
+#include "json_stream.h"
+
+/**
+ * Инициализация потокового разбора
+ * @param stream - состояние разбора
+ * @param key - ключ массива в объекте верхнего уровня, элементы которого передаются обработчику
+ * @param on_item - обработчик элемента массива
+ * @param userp - данные обработчика
+ */
+void json_stream_init(json_stream *stream, const char *key, json_stream_item_fn on_item, void *userp) {
+    memset(stream, 0, sizeof(json_stream));
+    stream->key = key;
+    stream->on_item = on_item;
+    stream->userp = userp;
+}
+
+/**
+ * Добавление данных к текущему элементу массива
+ * @return 0|1 - 0 успешно | 1 не удалось выделить память
+ */
+static int item_append(json_stream *stream, const char *data, size_t len) {
+    if (stream->item_len + len > stream->item_cap) {
+        size_t cap = stream->item_cap ? stream->item_cap : 1024;
+        while (cap < stream->item_len + len) {
+            cap *= 2;
+        }
+        char *item = realloc(stream->item, cap);
+        if (item == NULL) {
+            return 1;
+        }
+        stream->item = item;
+        stream->item_cap = cap;
+    }
+    memcpy(stream->item + stream->item_len, data, len);
+    stream->item_len += len;
+
+    return 0;
+}
+
+/**
+ * Разбор очередной порции данных
+ * @param stream - состояние разбора
+ * @param data - данные
+ * @param len - размер данных
+ * @return 0|1 - 0 успешно | 1 ошибка (json некорректен, нет памяти или разбор прерван обработчиком)
+ */
+int json_stream_feed(json_stream *stream, const char *data, size_t len) {
+    size_t item_start = 0; // начало данных текущего элемента в этой порции
+    int capturing = stream->item_len > 0;
+
+    for (size_t i = 0; i < len; ++i) {
+        char c = data[i];
+
+        if (stream->in_string) {
+            if (stream->escape) {
+                stream->escape = 0;
+            } else if (c == '\\') {
+                stream->escape = 1;
+            } else if (c == '"') {
+                stream->in_string = 0;
+                continue;
+            }
+            // запоминаем строки первого уровня, последняя перед '[' - ключ массива
+            if (stream->depth == 1 && !capturing) {
+                if (stream->last_len < JSON_STREAM_KEY_MAX) {
+                    stream->last[stream->last_len] = c;
+                }
+                stream->last_len++;
+            }
+            continue;
+        }
+
+        switch (c) {
+            case '"':
+                stream->in_string = 1;
+                if (stream->depth == 1) {
+                    stream->last_len = 0;
+                }
+                break;
+            case '{':
+            case '[':
+                if (stream->in_array && stream->depth == 2 && c == '{') {
+                    capturing = 1;
+                    item_start = i;
+                }
+                if (stream->depth == 1 && c == '[' && stream->last_len == strlen(stream->key)
+                    && !memcmp(stream->last, stream->key, stream->last_len)) {
+                    stream->in_array = 1;
+                }
+                stream->depth++;
+                break;
+            case '}':
+            case ']':
+                if (stream->depth == 0) {
+                    return 1;
+                }
+                stream->depth--;
+                if (stream->in_array && stream->depth == 1) {
+                    stream->in_array = 0;
+                }
+                if (capturing && stream->depth == 2) {
+                    if (item_append(stream, data + item_start, i + 1 - item_start)) {
+                        return 1;
+                    }
+                    capturing = 0;
+                    int stop = stream->on_item(stream->item, stream->item_len, stream->userp);
+                    stream->item_len = 0;
+                    if (stop) {
+                        return 1;
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    // незавершенный элемент сохраняем до следующей порции данных
+    if (capturing && item_append(stream, data + item_start, len - item_start)) {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * Освобождение памяти разбора
+ * @param stream - состояние разбора
+ */
+void json_stream_free(json_stream *stream) {
+    free(stream->item);
+    stream->item = NULL;
+    stream->item_len = 0;
+    stream->item_cap = 0;
+}
@@ -0,0 +1,38 @@
+#ifndef JSON_STREAM_H
+#define JSON_STREAM_H
+
+#include <stddef.h>
+
+#define JSON_STREAM_KEY_MAX 64
+
+/**
+ * Обработчик элемента массива: json элемента целиком (без нуль-символа)
+ * @return 0|1 - 0 продолжить разбор | 1 прервать разбор
+ */
+typedef int (*json_stream_item_fn)(const char *json, size_t len, void *userp);
+
+/**
+ * Потоковый разбор json по мере получения данных. Из объекта верхнего уровня выделяются
+ * элементы-объекты массива с ключом key, остальные данные пропускаются без сохранения.
+ * В памяти хранится только текущий элемент массива
+ */
+typedef struct {
+    const char *key; // ключ массива в объекте верхнего уровня
+    json_stream_item_fn on_item; // обработчик элемента массива
+    void *userp; // данные обработчика
+    int depth; // текущая вложенность
+    int in_string; // 1 - внутри строки
+    int escape; // 1 - предыдущий символ строки '\'
+    int in_array; // 1 - внутри массива с ключом key
+    char last[JSON_STREAM_KEY_MAX]; // последняя строка на первом уровне вложенности (ключ)
+    size_t last_len; // длина last, больше JSON_STREAM_KEY_MAX - строка не поместилась
+    char *item; // данные текущего элемента массива
+    size_t item_len; // размер данных текущего элемента, 0 - элемент не начат
+    size_t item_cap; // размер выделенной памяти под элемент
+} json_stream;
+
+void json_stream_init(json_stream *stream, const char *key, json_stream_item_fn on_item, void *userp);
+int json_stream_feed(json_stream *stream, const char *data, size_t len);
+void json_stream_free(json_stream *stream);
+
+#endif
@@ -120,6 +120,10 @@ typedef struct cJSON
 
     /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
     char *string;
+
+    /* Lookup index of a large array or object, built by cJSON_IndexArray/cJSON_IndexObject and maintained or dropped by the
+     * functions that change the children. Drop it with cJSON_InvalidateIndex after changing next/prev/child/string directly. */
+    struct cJSON_Index *index;
 } cJSON;
 
 typedef struct cJSON_Hooks
@@ -152,6 +156,83 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_len
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
 
+/* Arena allocation for parse trees. cJSON_ParseWithLengthArena allocates every node and string of the
+ * tree from the arena instead of one malloc each. The tree is released all at once with cJSON_ResetArena
+ * (which keeps the blocks for the next parse) or cJSON_DeleteArena and must NOT be passed to cJSON_Delete.
+ * Treat such trees as read-only: functions that add, replace or delete items use the global hooks.
+ * block_size 0 selects the default block size. */
+typedef struct cJSON_Arena cJSON_Arena;
+CJSON_PUBLIC(cJSON_Arena *) cJSON_CreateArena(size_t block_size);
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthArena(const char *value, size_t buffer_length, cJSON_Arena *arena);
+CJSON_PUBLIC(void) cJSON_ResetArena(cJSON_Arena *arena);
+CJSON_PUBLIC(void) cJSON_DeleteArena(cJSON_Arena *arena);
+
+/* Per-call parse context: allocator and error state belong to the call instead of the process-wide
+ * hooks and cJSON_GetErrorPtr, so threads can parse concurrently with their own (e.g. thread-local pool)
+ * allocators and without sharing error state.
+ * allocate/deallocate receive userdata; when allocate is NULL the global hooks are used.
+ * When arena is set the tree comes from the arena and the allocator is ignored.
+ * Trees parsed with a context are released with cJSON_DeleteWithContext and the same context.
+ * On return parse_end points where parsing stopped, error is NULL on success or the error position. */
+typedef struct cJSON_Context
+{
+    void *(CJSON_CDECL *allocate)(size_t size, void *userdata);
+    void (CJSON_CDECL *deallocate)(void *pointer, void *userdata);
+    void *userdata;
+    cJSON_Arena *arena;
+    cJSON_bool require_null_terminated;
+    const char *parse_end;
+    const char *error;
+} cJSON_Context;
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithContext(const char *value, size_t buffer_length, cJSON_Context *context);
+CJSON_PUBLIC(void) cJSON_DeleteWithContext(cJSON *item, const cJSON_Context *context);
+
+/* Callback for cJSON_ExtractPaths. path_index is the position of the matched path in the paths array,
+ * element is the index of the innermost array element on the way to the value (-1 if there is none).
+ * value is only valid during the call. Return false to stop the extraction. */
+typedef cJSON_bool (*cJSON_PathCallback)(int path_index, int element, const cJSON *value, void *userdata);
+/* Extract the values at the given paths in a single pass over the text, without building nodes for anything that is not requested.
+ * A path is a list of keys separated by '.', where [n] selects array element n and [*] selects every element, e.g. "consolidated_weather[*].min_temp".
+ * Keys are compared without decoding escape sequences. Up to 32 paths of up to 16 segments each; a path that ends
+ * at a value stops there, so paths should not be prefixes of one another.
+ * Skipped values are checked like cJSON_Parse checks them, so it accepts the same documents. Values in front of an
+ * error have already been passed to the callback when the error is found.
+ * Returns false if a path can't be parsed or the JSON is invalid (cJSON_GetErrorPtr then points at the error). */
+CJSON_PUBLIC(cJSON_bool) cJSON_ExtractPaths(const char *value, size_t buffer_length, const char * const *paths, int path_count, cJSON_PathCallback callback, void *userdata);
+
+/* Read-only tape: the document is parsed into one contiguous array of tokens in document order instead of a tree of nodes.
+ * Strings, keys and numbers are not copied, the tokens refer to the text, so the text has to outlive the tape.
+ * A tape is a single allocation that is navigated with iterators; skipping an array or object of any size is one step.
+ * Returns NULL if the JSON is invalid (cJSON_GetErrorPtr then points at the error). Free the tape with cJSON_DeleteTape. */
+typedef struct cJSON_Tape cJSON_Tape;
+typedef struct cJSON_TapeIterator
+{
+    const cJSON_Tape *tape;
+    size_t position; /* index of the current token */
+    size_t end; /* index after the last token of the parent, the iterator is invalid once it gets there */
+} cJSON_TapeIterator;
+CJSON_PUBLIC(cJSON_Tape *) cJSON_ParseTape(const char *value, size_t buffer_length);
+CJSON_PUBLIC(void) cJSON_DeleteTape(cJSON_Tape *tape);
+/* The root value, its first child and its next sibling. Past the last sibling the iterator becomes invalid. */
+CJSON_PUBLIC(cJSON_TapeIterator) cJSON_TapeRoot(const cJSON_Tape *tape);
+CJSON_PUBLIC(cJSON_TapeIterator) cJSON_TapeChild(cJSON_TapeIterator iterator);
+CJSON_PUBLIC(cJSON_TapeIterator) cJSON_TapeNext(cJSON_TapeIterator iterator);
+CJSON_PUBLIC(cJSON_bool) cJSON_TapeIsValid(cJSON_TapeIterator iterator);
+/* cJSON_False ... cJSON_Object, cJSON_Invalid for an invalid iterator */
+CJSON_PUBLIC(int) cJSON_TapeType(cJSON_TapeIterator iterator);
+CJSON_PUBLIC(int) cJSON_TapeGetSize(cJSON_TapeIterator iterator);
+CJSON_PUBLIC(cJSON_TapeIterator) cJSON_TapeGetArrayItem(cJSON_TapeIterator array, int index);
+/* Case sensitive, keys are compared without decoding escape sequences. */
+CJSON_PUBLIC(cJSON_TapeIterator) cJSON_TapeGetObjectItem(cJSON_TapeIterator object, const char *string);
+/* The key of an object member as it is in the text (without quotes, not NUL terminated), NULL if there is none. */
+CJSON_PUBLIC(const char *) cJSON_TapeGetKey(cJSON_TapeIterator iterator, size_t *length);
+CJSON_PUBLIC(double) cJSON_TapeGetNumber(cJSON_TapeIterator iterator);
+/* Decode a string into buffer like snprintf: the result is truncated to size - 1 bytes and NUL terminated.
+ * Returns the length of the whole decoded string, 0 if the value is not a string. */
+CJSON_PUBLIC(size_t) cJSON_TapeGetString(cJSON_TapeIterator iterator, char *buffer, size_t size);
+/* The text of the value (strings without quotes), not NUL terminated. */
+CJSON_PUBLIC(const char *) cJSON_TapeGetRaw(cJSON_TapeIterator iterator, size_t *length);
+
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
 /* Render a cJSON entity to text for transfer/storage without any formatting. */
@@ -164,14 +245,26 @@ CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, cons
 /* Delete a cJSON entity and all subentities. */
 CJSON_PUBLIC(void) cJSON_Delete(cJSON *item);
 
+/* Size and item access are O(1) on arrays indexed with cJSON_IndexArray and walk the items otherwise. */
 /* Returns the number of items in an array (or object). */
 CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array);
 /* Retrieve item number "index" from array "array". Returns NULL if unsuccessful. */
 CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index);
 /* Get item "string" from object. Case insensitive. */
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItem(const cJSON * const object, const char * const string);
+/* Case sensitive lookups are O(1) in objects indexed with cJSON_IndexObject and walk the children otherwise. */
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemCaseSensitive(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON_bool) cJSON_HasObjectItem(const cJSON *object, const char *string);
+/* Build a hash index of the keys of an object, worth it for objects with many keys that are looked up often.
+ * Lookups never modify the object, index it before sharing it between threads. Appending keeps the index,
+ * detaching, inserting and replacing drop it. The index is allocated with the global hooks, objects of trees
+ * parsed into an arena or with the allocator of a cJSON_Context and references can't be indexed (returns 0). */
+CJSON_PUBLIC(cJSON_bool) cJSON_IndexObject(cJSON *object);
+/* Build a vector of the items of an array, the same caveats apply. Appending and detaching, deleting, inserting and
+ * replacing by position keep it, detaching and replacing via pointer drop it, index again after such a batch of changes. */
+CJSON_PUBLIC(cJSON_bool) cJSON_IndexArray(cJSON *array);
+/* Drop the index of an array or object whose children or keys were changed without the cJSON functions. */
+CJSON_PUBLIC(void) cJSON_InvalidateIndex(cJSON *object);
 /* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when cJSON_Parse() returns 0. 0 when cJSON_Parse() succeeds. */
 CJSON_PUBLIC(const char *) cJSON_GetErrorPtr(void);
 
@@ -281,6 +374,8 @@ CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
 
 /* Macro for iterating over an array or object */
 #define cJSON_ArrayForEach(element, array) for(element = (array != NULL) ? (array)->child : NULL; element != NULL; element = element->next)
+/* Macro for iterating over the children of a tape array or object */
+#define cJSON_TapeForEach(element, container) for(element = cJSON_TapeChild(container); cJSON_TapeIsValid(element); element = cJSON_TapeNext(element))
 
 /* malloc/free objects using the malloc/free functions that have been set with cJSON_InitHooks */
 CJSON_PUBLIC(void *) cJSON_malloc(size_t size);
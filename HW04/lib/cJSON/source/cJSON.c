@@ -45,6 +45,17 @@
 #include <ctype.h>
 #include <float.h>
 
+/* SSE2 string scanning, define CJSON_NO_SIMD to use the scalar scanner only */
+#if !defined(CJSON_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define CJSON_SSE2
+#include <emmintrin.h>
+#endif
+
+/* number conversion without libc that works on the bits of a double needs a 64 bit unsigned long and IEEE 754 doubles */
+#if ((ULONG_MAX / 4294967295UL) > 4294967295UL) && (FLT_RADIX == 2) && (DBL_MANT_DIG == 53) && (DBL_MAX_EXP == 1024)
+#define CJSON_64BIT_DOUBLES
+#endif
+
 #ifdef ENABLE_LOCALES
 #include <locale.h>
 #endif
@@ -249,933 +260,3901 @@ static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
     return node;
 }
 
-/* Delete a cJSON structure. */
-CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
-{
-    cJSON *next = NULL;
-    while (item != NULL)
-    {
-        next = item->next;
-        if (!(item->type & cJSON_IsReference) && (item->child != NULL))
-        {
-            cJSON_Delete(item->child);
-        }
-        if (!(item->type & cJSON_IsReference) && (item->valuestring != NULL))
-        {
-            global_hooks.deallocate(item->valuestring);
-        }
-        if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
-        {
-            global_hooks.deallocate(item->string);
-        }
-        global_hooks.deallocate(item);
-        item = next;
-    }
-}
+/* Arena for parse trees: nodes and strings are bump allocated from blocks,
+ * the whole tree is released at once by resetting or deleting the arena */
+#define ARENA_DEFAULT_BLOCK_SIZE 4096
 
-/* get the decimal point character of the current locale */
-static unsigned char get_decimal_point(void)
+typedef union
 {
-#ifdef ENABLE_LOCALES
-    struct lconv *lconv = localeconv();
-    return (unsigned char) lconv->decimal_point[0];
-#else
-    return '.';
-#endif
-}
+    double number;
+    long integer;
+    void *pointer;
+} arena_align;
 
-typedef struct
+#define arena_round(size) ((((size) + sizeof(arena_align) - 1) / sizeof(arena_align)) * sizeof(arena_align))
+
+typedef struct arena_block
 {
-    const unsigned char *content;
-    size_t length;
-    size_t offset;
-    size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
-    internal_hooks hooks;
-} parse_buffer;
+    struct arena_block *next;
+    size_t size; /* usable bytes after the header */
+    size_t used;
+} arena_block;
 
-/* check if the given size is left to read in a given parse buffer (starting with 1) */
-#define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
-/* check if the buffer can be accessed at the given index (starting with 0) */
-#define can_access_at_index(buffer, index) ((buffer != NULL) && (((buffer)->offset + index) < (buffer)->length))
-#define cannot_access_at_index(buffer, index) (!can_access_at_index(buffer, index))
-/* get a pointer to the buffer at the position */
-#define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
+#define ARENA_HEADER_SIZE arena_round(sizeof(arena_block))
 
-/* Parse the input text to generate a number, and populate the result into item. */
-static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
+struct cJSON_Arena
 {
-    double number = 0;
-    unsigned char *after_end = NULL;
-    unsigned char number_c_string[64];
-    unsigned char decimal_point = get_decimal_point();
-    size_t i = 0;
+    arena_block *head;
+    arena_block *current; /* block allocations are taken from, blocks after it are free for reuse */
+    size_t block_size;
+};
 
-    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+CJSON_PUBLIC(cJSON_Arena *) cJSON_CreateArena(size_t block_size)
+{
+    cJSON_Arena *arena = (cJSON_Arena*)global_hooks.allocate(sizeof(cJSON_Arena));
+    if (arena == NULL)
     {
-        return false;
+        return NULL;
     }
 
-    /* copy the number into a temporary buffer and replace '.' with the decimal point
-     * of the current locale (for strtod)
-     * This also takes care of '\0' not necessarily being available for marking the end of the input */
-    for (i = 0; (i < (sizeof(number_c_string) - 1)) && can_access_at_index(input_buffer, i); i++)
-    {
-        switch (buffer_at_offset(input_buffer)[i])
-        {
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9':
-            case '+':
-            case '-':
-            case 'e':
-            case 'E':
-                number_c_string[i] = buffer_at_offset(input_buffer)[i];
-                break;
+    arena->head = NULL;
+    arena->current = NULL;
+    arena->block_size = (block_size > 0) ? block_size : ARENA_DEFAULT_BLOCK_SIZE;
 
-            case '.':
-                number_c_string[i] = decimal_point;
-                break;
+    return arena;
+}
 
-            default:
-                goto loop_end;
+static void *arena_allocate(cJSON_Arena * const arena, size_t size)
+{
+    arena_block *block = NULL;
+    arena_block **link = NULL;
+    size = arena_round(size);
+
+    /* reuse the blocks left over from before the last reset */
+    while ((arena->current != NULL) && ((arena->current->size - arena->current->used) < size))
+    {
+        if ((arena->current->next == NULL) || (arena->current->next->size < size))
+        {
+            break;
         }
+        arena->current = arena->current->next;
+        arena->current->used = 0;
     }
-loop_end:
-    number_c_string[i] = '\0';
 
-    number = strtod((const char*)number_c_string, (char**)&after_end);
-    if (number_c_string == after_end)
+    if ((arena->current == NULL) || ((arena->current->size - arena->current->used) < size))
     {
-        return false; /* parse_error */
+        size_t block_size = (size > arena->block_size) ? size : arena->block_size;
+        block = (arena_block*)global_hooks.allocate(ARENA_HEADER_SIZE + block_size);
+        if (block == NULL)
+        {
+            return NULL;
+        }
+        block->size = block_size;
+        block->used = 0;
+
+        /* insert after the current block, so that the free blocks behind it stay reachable */
+        link = (arena->current != NULL) ? &arena->current->next : &arena->head;
+        block->next = *link;
+        *link = block;
+        arena->current = block;
     }
 
-    item->valuedouble = number;
+    block = arena->current;
+    block->used += size;
 
-    /* use saturation in case of overflow */
-    if (number >= INT_MAX)
+    return (unsigned char*)block + ARENA_HEADER_SIZE + block->used - size;
+}
+
+CJSON_PUBLIC(void) cJSON_ResetArena(cJSON_Arena *arena)
+{
+    if ((arena == NULL) || (arena->head == NULL))
     {
-        item->valueint = INT_MAX;
+        return;
     }
-    else if (number <= (double)INT_MIN)
+
+    arena->current = arena->head;
+    arena->current->used = 0;
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteArena(cJSON_Arena *arena)
+{
+    arena_block *block = NULL;
+    if (arena == NULL)
     {
-        item->valueint = INT_MIN;
+        return;
     }
-    else
+
+    block = arena->head;
+    while (block != NULL)
     {
-        item->valueint = (int)number;
+        arena_block *next = block->next;
+        global_hooks.deallocate(block);
+        block = next;
     }
-
-    item->type = cJSON_Number;
-
-    input_buffer->offset += (size_t)(after_end - number_c_string);
-    return true;
+    global_hooks.deallocate(arena);
 }
 
-/* don't ask me, but the original cJSON_SetNumberValue returns an integer or double */
-CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number)
+/* Allocation through a per-call context, the global hooks when it has no allocator */
+static void *context_allocate(const cJSON_Context * const context, size_t size)
 {
-    if (number >= INT_MAX)
+    if ((context != NULL) && (context->allocate != NULL))
     {
-        object->valueint = INT_MAX;
-    }
-    else if (number <= (double)INT_MIN)
-    {
-        object->valueint = INT_MIN;
+        return context->allocate(size, context->userdata);
     }
-    else
+
+    return global_hooks.allocate(size);
+}
+
+static void context_deallocate(const cJSON_Context * const context, void *pointer)
+{
+    if ((context != NULL) && (context->allocate != NULL))
     {
-        object->valueint = (int)number;
+        if (context->deallocate != NULL)
+        {
+            context->deallocate(pointer, context->userdata);
+        }
+        return;
     }
 
-    return object->valuedouble = number;
+    global_hooks.deallocate(pointer);
 }
 
-CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
+/* Lookup index of a large array or object, built on request by cJSON_IndexArray and cJSON_IndexObject.
+ * Arrays get a vector of their children, objects a hash table of their keys. Appending keeps either in step
+ * and grows it, replacing an array item by its position swaps the pointer, every other change drops it.
+ * It is allocated with the global hooks, so trees whose memory comes from an arena or from the allocator
+ * of a cJSON_Context are never indexed. */
+#define INDEX_MIN_CHILDREN 32
+
+typedef struct
 {
-    char *copy = NULL;
-    /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring */
-    if (!(object->type & cJSON_String) || (object->type & cJSON_IsReference))
+    unsigned long hash;
+    cJSON *item;
+} index_slot;
+
+struct cJSON_Index
+{
+    size_t count; /* children of an array, indexed keys of an object */
+    size_t size; /* vector capacity of an array, slot count of an object (a power of two of at least twice count) */
+    cJSON_bool truncated; /* a child without key ends an object's index, like it ends the linear lookup */
+    cJSON **items; /* array: the children in order */
+    index_slot *slots; /* object: open addressing hash table */
+};
+
+/* marks items that must not get an index because it would not be allocated like the rest of the tree (arena and context trees) */
+static struct cJSON_Index no_index;
+
+/* FNV-1a */
+static unsigned long hash_key(const unsigned char *key)
+{
+    unsigned long hash = 2166136261UL;
+    for (; *key != '\0'; key++)
     {
-        return NULL;
+        hash = (hash ^ *key) * 16777619UL;
     }
-    if (strlen(valuestring) <= strlen(object->valuestring))
+
+    return hash;
+}
+
+static void delete_index(cJSON * const item)
+{
+    if ((item->index != NULL) && (item->index != &no_index))
     {
-        strcpy(object->valuestring, valuestring);
-        return object->valuestring;
+        global_hooks.deallocate(item->index);
+        item->index = NULL;
     }
-    copy = (char*) cJSON_strdup((const unsigned char*)valuestring, &global_hooks);
-    if (copy == NULL)
+}
+
+/* header and storage in one allocation */
+static struct cJSON_Index *allocate_index(const size_t storage)
+{
+    struct cJSON_Index *index = (struct cJSON_Index*)global_hooks.allocate(sizeof(struct cJSON_Index) + storage);
+    if (index != NULL)
     {
-        return NULL;
+        memset(index, '\0', sizeof(struct cJSON_Index) + storage);
     }
-    if (object->valuestring != NULL)
+
+    return index;
+}
+
+static size_t count_children(const cJSON * const item)
+{
+    const cJSON *child = NULL;
+    size_t children = 0;
+    for (child = item->child; child != NULL; child = child->next)
     {
-        cJSON_free(object->valuestring);
+        children++;
     }
-    object->valuestring = copy;
 
-    return copy;
+    return children;
 }
 
-typedef struct
+/* add a key, the first child with a key stays the one that is found */
+static void index_insert_key(struct cJSON_Index * const index, cJSON * const item, const unsigned long hash)
 {
-    unsigned char *buffer;
-    size_t length;
-    size_t offset;
-    size_t depth; /* current nesting depth (for formatted printing) */
-    cJSON_bool noalloc;
-    cJSON_bool format; /* is this print a formatted print */
-    internal_hooks hooks;
-} printbuffer;
+    size_t position = (size_t)hash & (index->size - 1);
+    while (index->slots[position].item != NULL)
+    {
+        if ((index->slots[position].hash == hash) && (strcmp(index->slots[position].item->string, item->string) == 0))
+        {
+            return;
+        }
+        position = (position + 1) & (index->size - 1);
+    }
+    index->slots[position].hash = hash;
+    index->slots[position].item = item;
+    index->count++;
+}
 
-/* realloc printbuffer if necessary to have at least "needed" bytes more */
-static unsigned char* ensure(printbuffer * const p, size_t needed)
+/* replaces an existing index, on failure the object is left without one and lookups are linear */
+static cJSON_bool build_object_index(cJSON * const object)
 {
-    unsigned char *newbuffer = NULL;
-    size_t newsize = 0;
+    struct cJSON_Index *index = NULL;
+    cJSON *child = NULL;
+    size_t children = count_children(object);
+    size_t slot_count = 2 * INDEX_MIN_CHILDREN;
 
-    if ((p == NULL) || (p->buffer == NULL))
+    while (slot_count < (children * 2))
     {
-        return NULL;
+        slot_count *= 2;
     }
 
-    if ((p->length > 0) && (p->offset >= p->length))
+    delete_index(object);
+    index = allocate_index(slot_count * sizeof(index_slot));
+    if (index == NULL)
     {
-        /* make sure that offset is valid */
-        return NULL;
+        return false;
     }
+    index->size = slot_count;
+    index->slots = (index_slot*)(void*)(index + 1);
 
-    if (needed > INT_MAX)
+    for (child = object->child; child != NULL; child = child->next)
     {
-        /* sizes bigger than INT_MAX are currently not supported */
-        return NULL;
+        if (child->string == NULL)
+        {
+            index->truncated = true;
+            break;
+        }
+        index_insert_key(index, child, hash_key((const unsigned char*)child->string));
     }
 
-    needed += p->offset + 1;
-    if (needed <= p->length)
+    object->index = index;
+
+    return true;
+}
+
+static cJSON *index_lookup(const struct cJSON_Index * const index, const char * const name)
+{
+    unsigned long hash = hash_key((const unsigned char*)name);
+    size_t position = (size_t)hash & (index->size - 1);
+    while (index->slots[position].item != NULL)
     {
-        return p->buffer + p->offset;
+        if ((index->slots[position].hash == hash) && (strcmp(index->slots[position].item->string, name) == 0))
+        {
+            return index->slots[position].item;
+        }
+        position = (position + 1) & (index->size - 1);
     }
 
-    if (p->noalloc) {
-        return NULL;
+    return NULL;
+}
+
+/* replaces an existing index, on failure the array is left without one and access is linear */
+static cJSON_bool build_array_index(cJSON * const array)
+{
+    struct cJSON_Index *index = NULL;
+    cJSON *child = NULL;
+    size_t children = count_children(array);
+    size_t size = (children > INDEX_MIN_CHILDREN) ? children : INDEX_MIN_CHILDREN;
+
+    /* room to append as many children again before it has to grow */
+    delete_index(array);
+    index = allocate_index(2 * size * sizeof(cJSON*));
+    if (index == NULL)
+    {
+        return false;
     }
+    index->size = 2 * size;
+    index->items = (cJSON**)(void*)(index + 1);
 
-    /* calculate new buffer size */
-    if (needed > (INT_MAX / 2))
+    for (child = array->child; child != NULL; child = child->next)
     {
-        /* overflow of int, use INT_MAX if possible */
-        if (needed <= INT_MAX)
+        index->items[index->count++] = child;
+    }
+
+    array->index = index;
+
+    return true;
+}
+
+/* keep the index in step with a child appended to the array or object */
+static void index_append(cJSON * const parent, cJSON * const item)
+{
+    struct cJSON_Index *index = parent->index;
+    if ((index == NULL) || (index == &no_index))
+    {
+        return;
+    }
+
+    if (index->items != NULL)
+    {
+        if (index->count < index->size)
         {
-            newsize = INT_MAX;
+            index->items[index->count++] = item;
         }
         else
         {
-            return NULL;
+            /* full, the array asked for an index, so it gets a larger one */
+            build_array_index(parent);
         }
     }
-    else
+    else if (index->truncated)
     {
-        newsize = needed * 2;
+        return;
     }
-
-    if (p->hooks.reallocate != NULL)
+    else if (item->string == NULL)
     {
-        /* reallocate with realloc if available */
-        newbuffer = (unsigned char*)p->hooks.reallocate(p->buffer, newsize);
-        if (newbuffer == NULL)
-        {
-            p->hooks.deallocate(p->buffer);
-            p->length = 0;
-            p->buffer = NULL;
-
-            return NULL;
-        }
+        index->truncated = true;
+        return;
+    }
+    else if (((index->count + 1) * 2) <= index->size)
+    {
+        index_insert_key(index, item, hash_key((const unsigned char*)item->string));
     }
     else
     {
-        /* otherwise reallocate manually */
-        newbuffer = (unsigned char*)p->hooks.allocate(newsize);
-        if (!newbuffer)
-        {
-            p->hooks.deallocate(p->buffer);
-            p->length = 0;
-            p->buffer = NULL;
-
-            return NULL;
-        }
-        
-        memcpy(newbuffer, p->buffer, p->offset + 1);
-        p->hooks.deallocate(p->buffer);
+        /* full, the object asked for an index, so it gets a larger one */
+        build_object_index(parent);
     }
-    p->length = newsize;
-    p->buffer = newbuffer;
-
-    return newbuffer + p->offset;
 }
 
-/* calculate the new length of the string in a printbuffer and update the offset */
-static void update_offset(printbuffer * const buffer)
+/* keep an array's vector in step with the child at position being replaced, removed or inserted in front of.
+ * Position is only known for changes by position (INDEX_UNKNOWN_POSITION otherwise), the index is dropped without it */
+#define INDEX_UNKNOWN_POSITION ((size_t)-1)
+static void index_replace(cJSON * const parent, const size_t position, const cJSON * const item, cJSON * const replacement)
 {
-    const unsigned char *buffer_pointer = NULL;
-    if ((buffer == NULL) || (buffer->buffer == NULL))
+    struct cJSON_Index *index = parent->index;
+    if ((index != NULL) && (index->items != NULL) && (position < index->count) && (index->items[position] == item))
     {
+        index->items[position] = replacement;
         return;
     }
-    buffer_pointer = buffer->buffer + buffer->offset;
 
-    buffer->offset += strlen((const char*)buffer_pointer);
+    delete_index(parent);
 }
 
-/* securely comparison of floating-point variables */
-static cJSON_bool compare_double(double a, double b)
+static void index_remove(cJSON * const parent, const size_t position, const cJSON * const item)
 {
-    double maxVal = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
-    return (fabs(a - b) <= maxVal * DBL_EPSILON);
+    struct cJSON_Index *index = parent->index;
+    if ((index != NULL) && (index->items != NULL) && (position < index->count) && (index->items[position] == item))
+    {
+        memmove(&index->items[position], &index->items[position + 1], (index->count - position - 1) * sizeof(cJSON*));
+        index->count--;
+        return;
+    }
+
+    delete_index(parent);
 }
 
-/* Render the number nicely from the given item into a string. */
-static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+/* called after item has been linked in front of the child that was at position */
+static void index_insert(cJSON * const parent, const size_t position, cJSON * const item)
 {
-    unsigned char *output_pointer = NULL;
-    double d = item->valuedouble;
-    int length = 0;
-    size_t i = 0;
-    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
+    struct cJSON_Index *index = parent->index;
+    if ((index != NULL) && (index->items != NULL) && (position < index->count) && (index->items[position] == item->next))
+    {
+        if (index->count < index->size)
+        {
+            memmove(&index->items[position + 1], &index->items[position], (index->count - position) * sizeof(cJSON*));
+            index->items[position] = item;
+            index->count++;
+        }
+        else
+        {
+            /* full, the array asked for an index, so it gets a larger one */
+            build_array_index(parent);
+        }
+        return;
+    }
+
+    delete_index(parent);
+}
+
+static void delete_item(cJSON *item, const cJSON_Context * const context)
+{
+    cJSON *next = NULL;
+    while (item != NULL)
+    {
+        next = item->next;
+        if (!(item->type & cJSON_IsReference) && (item->child != NULL))
+        {
+            delete_item(item->child, context);
+        }
+        if (!(item->type & cJSON_IsReference) && (item->valuestring != NULL))
+        {
+            context_deallocate(context, item->valuestring);
+        }
+        if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
+        {
+            context_deallocate(context, item->string);
+        }
+        delete_index(item);
+        context_deallocate(context, item);
+        item = next;
+    }
+}
+
+/* Delete a cJSON structure. */
+CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
+{
+    delete_item(item, NULL);
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteWithContext(cJSON *item, const cJSON_Context *context)
+{
+    /* arena trees are released with the arena */
+    if ((context != NULL) && (context->arena != NULL))
+    {
+        return;
+    }
+
+    delete_item(item, context);
+}
+
+/* get the decimal point character of the current locale */
+static unsigned char get_decimal_point(void)
+{
+#ifdef ENABLE_LOCALES
+    struct lconv *lconv = localeconv();
+    return (unsigned char) lconv->decimal_point[0];
+#else
+    return '.';
+#endif
+}
+
+typedef struct
+{
+    const unsigned char *content;
+    size_t length;
+    size_t offset;
+    size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
+    internal_hooks hooks;
+    cJSON_Arena *arena; /* when set, the tree is allocated from the arena instead of the hooks */
+    const cJSON_Context *context; /* when set, the tree is allocated through the context instead of the hooks */
+} parse_buffer;
+
+static void *parse_allocate(const parse_buffer * const buffer, size_t size)
+{
+    if (buffer->arena != NULL)
+    {
+        return arena_allocate(buffer->arena, size);
+    }
+    if (buffer->context != NULL)
+    {
+        return context_allocate(buffer->context, size);
+    }
+
+    return buffer->hooks.allocate(size);
+}
+
+/* whether the items of the parsed tree come from the global hooks, like the lookup indexes do */
+static cJSON_bool parse_uses_global_hooks(const parse_buffer * const buffer)
+{
+    return (buffer->arena == NULL) && ((buffer->context == NULL) || (buffer->context->allocate == NULL));
+}
+
+static void parse_deallocate(const parse_buffer * const buffer, void *pointer)
+{
+    /* arena memory is only released together with the arena */
+    if (buffer->arena != NULL)
+    {
+        return;
+    }
+    if (buffer->context != NULL)
+    {
+        context_deallocate(buffer->context, pointer);
+        return;
+    }
+
+    buffer->hooks.deallocate(pointer);
+}
+
+static cJSON *parse_new_item(const parse_buffer * const buffer)
+{
+    cJSON *node = (cJSON*)parse_allocate(buffer, sizeof(cJSON));
+    if (node)
+    {
+        memset(node, '\0', sizeof(cJSON));
+    }
+
+    return node;
+}
+
+static void parse_delete(const parse_buffer * const buffer, cJSON *item)
+{
+    if (buffer->arena == NULL)
+    {
+        delete_item(item, buffer->context);
+    }
+}
+
+/* check if the given size is left to read in a given parse buffer (starting with 1) */
+#define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
+/* check if the buffer can be accessed at the given index (starting with 0) */
+#define can_access_at_index(buffer, index) ((buffer != NULL) && (((buffer)->offset + index) < (buffer)->length))
+#define cannot_access_at_index(buffer, index) (!can_access_at_index(buffer, index))
+/* get a pointer to the buffer at the position */
+#define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
+
+/* Clinger's fast path: a mantissa below 2^53 times or divided by one of the powers of ten that are exact
+ * in a double is a single correctly rounded operation. Not safe when doubles are evaluated in extended precision. */
+#if defined(FLT_EVAL_METHOD)
+#define CJSON_FLT_EVAL_METHOD FLT_EVAL_METHOD
+#elif defined(__FLT_EVAL_METHOD__)
+#define CJSON_FLT_EVAL_METHOD __FLT_EVAL_METHOD__
+#else
+#define CJSON_FLT_EVAL_METHOD 0
+#endif
+#if (CJSON_FLT_EVAL_METHOD == 0) || (CJSON_FLT_EVAL_METHOD == 1)
+#define CJSON_FAST_NUMBERS
+#endif
+
+#define EXACT_POWER_MAX 22
+
+static const double exact_powers_of_ten[EXACT_POWER_MAX + 1] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* The Eisel-Lemire algorithm rounds a mantissa of up to 19 digits times a power of ten correctly
+ * with 64 bit integer arithmetic. */
+#ifdef CJSON_64BIT_DOUBLES
+
+#define LEMIRE_POWER_MIN (-342)
+#define LEMIRE_POWER_MAX 308
+
+/* 128 bit mantissas of 10^(index + LEMIRE_POWER_MIN) rounded down, { low, high } */
+static const unsigned long lemire_powers_of_ten[LEMIRE_POWER_MAX - LEMIRE_POWER_MIN + 1][2] =
+{
+    { 0x113FAA2906A13B3FUL, 0xEEF453D6923BD65AUL },
+    { 0x4AC7CA59A424C507UL, 0x9558B4661B6565F8UL },
+    { 0x5D79BCF00D2DF649UL, 0xBAAEE17FA23EBF76UL },
+    { 0xF4D82C2C107973DCUL, 0xE95A99DF8ACE6F53UL },
+    { 0x79071B9B8A4BE869UL, 0x91D8A02BB6C10594UL },
+    { 0x9748E2826CDEE284UL, 0xB64EC836A47146F9UL },
+    { 0xFD1B1B2308169B25UL, 0xE3E27A444D8D98B7UL },
+    { 0xFE30F0F5E50E20F7UL, 0x8E6D8C6AB0787F72UL },
+    { 0xBDBD2D335E51A935UL, 0xB208EF855C969F4FUL },
+    { 0xAD2C788035E61382UL, 0xDE8B2B66B3BC4723UL },
+    { 0x4C3BCB5021AFCC31UL, 0x8B16FB203055AC76UL },
+    { 0xDF4ABE242A1BBF3DUL, 0xADDCB9E83C6B1793UL },
+    { 0xD71D6DAD34A2AF0DUL, 0xD953E8624B85DD78UL },
+    { 0x8672648C40E5AD68UL, 0x87D4713D6F33AA6BUL },
+    { 0x680EFDAF511F18C2UL, 0xA9C98D8CCB009506UL },
+    { 0x0212BD1B2566DEF2UL, 0xD43BF0EFFDC0BA48UL },
+    { 0x014BB630F7604B57UL, 0x84A57695FE98746DUL },
+    { 0x419EA3BD35385E2DUL, 0xA5CED43B7E3E9188UL },
+    { 0x52064CAC828675B9UL, 0xCF42894A5DCE35EAUL },
+    { 0x7343EFEBD1940993UL, 0x818995CE7AA0E1B2UL },
+    { 0x1014EBE6C5F90BF8UL, 0xA1EBFB4219491A1FUL },
+    { 0xD41A26E077774EF6UL, 0xCA66FA129F9B60A6UL },
+    { 0x8920B098955522B4UL, 0xFD00B897478238D0UL },
+    { 0x55B46E5F5D5535B0UL, 0x9E20735E8CB16382UL },
+    { 0xEB2189F734AA831DUL, 0xC5A890362FDDBC62UL },
+    { 0xA5E9EC7501D523E4UL, 0xF712B443BBD52B7BUL },
+    { 0x47B233C92125366EUL, 0x9A6BB0AA55653B2DUL },
+    { 0x999EC0BB696E840AUL, 0xC1069CD4EABE89F8UL },
+    { 0xC00670EA43CA250DUL, 0xF148440A256E2C76UL },
+    { 0x380406926A5E5728UL, 0x96CD2A865764DBCAUL },
+    { 0xC605083704F5ECF2UL, 0xBC807527ED3E12BCUL },
+    { 0xF7864A44C633682EUL, 0xEBA09271E88D976BUL },
+    { 0x7AB3EE6AFBE0211DUL, 0x93445B8731587EA3UL },
+    { 0x5960EA05BAD82964UL, 0xB8157268FDAE9E4CUL },
+    { 0x6FB92487298E33BDUL, 0xE61ACF033D1A45DFUL },
+    { 0xA5D3B6D479F8E056UL, 0x8FD0C16206306BABUL },
+    { 0x8F48A4899877186CUL, 0xB3C4F1BA87BC8696UL },
+    { 0x331ACDABFE94DE87UL, 0xE0B62E2929ABA83CUL },
+    { 0x9FF0C08B7F1D0B14UL, 0x8C71DCD9BA0B4925UL },
+    { 0x07ECF0AE5EE44DD9UL, 0xAF8E5410288E1B6FUL },
+    { 0xC9E82CD9F69D6150UL, 0xDB71E91432B1A24AUL },
+    { 0xBE311C083A225CD2UL, 0x892731AC9FAF056EUL },
+    { 0x6DBD630A48AAF406UL, 0xAB70FE17C79AC6CAUL },
+    { 0x092CBBCCDAD5B108UL, 0xD64D3D9DB981787DUL },
+    { 0x25BBF56008C58EA5UL, 0x85F0468293F0EB4EUL },
+    { 0xAF2AF2B80AF6F24EUL, 0xA76C582338ED2621UL },
+    { 0x1AF5AF660DB4AEE1UL, 0xD1476E2C07286FAAUL },
+    { 0x50D98D9FC890ED4DUL, 0x82CCA4DB847945CAUL },
+    { 0xE50FF107BAB528A0UL, 0xA37FCE126597973CUL },
+    { 0x1E53ED49A96272C8UL, 0xCC5FC196FEFD7D0CUL },
+    { 0x25E8E89C13BB0F7AUL, 0xFF77B1FCBEBCDC4FUL },
+    { 0x77B191618C54E9ACUL, 0x9FAACF3DF73609B1UL },
+    { 0xD59DF5B9EF6A2417UL, 0xC795830D75038C1DUL },
+    { 0x4B0573286B44AD1DUL, 0xF97AE3D0D2446F25UL },
+    { 0x4EE367F9430AEC32UL, 0x9BECCE62836AC577UL },
+    { 0x229C41F793CDA73FUL, 0xC2E801FB244576D5UL },
+    { 0x6B43527578C1110FUL, 0xF3A20279ED56D48AUL },
+    { 0x830A13896B78AAA9UL, 0x9845418C345644D6UL },
+    { 0x23CC986BC656D553UL, 0xBE5691EF416BD60CUL },
+    { 0x2CBFBE86B7EC8AA8UL, 0xEDEC366B11C6CB8FUL },
+    { 0x7BF7D71432F3D6A9UL, 0x94B3A202EB1C3F39UL },
+    { 0xDAF5CCD93FB0CC53UL, 0xB9E08A83A5E34F07UL },
+    { 0xD1B3400F8F9CFF68UL, 0xE858AD248F5C22C9UL },
+    { 0x23100809B9C21FA1UL, 0x91376C36D99995BEUL },
+    { 0xABD40A0C2832A78AUL, 0xB58547448FFFFB2DUL },
+    { 0x16C90C8F323F516CUL, 0xE2E69915B3FFF9F9UL },
+    { 0xAE3DA7D97F6792E3UL, 0x8DD01FAD907FFC3BUL },
+    { 0x99CD11CFDF41779CUL, 0xB1442798F49FFB4AUL },
+    { 0x40405643D711D583UL, 0xDD95317F31C7FA1DUL },
+    { 0x482835EA666B2572UL, 0x8A7D3EEF7F1CFC52UL },
+    { 0xDA3243650005EECFUL, 0xAD1C8EAB5EE43B66UL },
+    { 0x90BED43E40076A82UL, 0xD863B256369D4A40UL },
+    { 0x5A7744A6E804A291UL, 0x873E4F75E2224E68UL },
+    { 0x711515D0A205CB36UL, 0xA90DE3535AAAE202UL },
+    { 0x0D5A5B44CA873E03UL, 0xD3515C2831559A83UL },
+    { 0xE858790AFE9486C2UL, 0x8412D9991ED58091UL },
+    { 0x626E974DBE39A872UL, 0xA5178FFF668AE0B6UL },
+    { 0xFB0A3D212DC8128FUL, 0xCE5D73FF402D98E3UL },
+    { 0x7CE66634BC9D0B99UL, 0x80FA687F881C7F8EUL },
+    { 0x1C1FFFC1EBC44E80UL, 0xA139029F6A239F72UL },
+    { 0xA327FFB266B56220UL, 0xC987434744AC874EUL },
+    { 0x4BF1FF9F0062BAA8UL, 0xFBE9141915D7A922UL },
+    { 0x6F773FC3603DB4A9UL, 0x9D71AC8FADA6C9B5UL },
+    { 0xCB550FB4384D21D3UL, 0xC4CE17B399107C22UL },
+    { 0x7E2A53A146606A48UL, 0xF6019DA07F549B2BUL },
+    { 0x2EDA7444CBFC426DUL, 0x99C102844F94E0FBUL },
+    { 0xFA911155FEFB5308UL, 0xC0314325637A1939UL },
+    { 0x793555AB7EBA27CAUL, 0xF03D93EEBC589F88UL },
+    { 0x4BC1558B2F3458DEUL, 0x96267C7535B763B5UL },
+    { 0x9EB1AAEDFB016F16UL, 0xBBB01B9283253CA2UL },
+    { 0x465E15A979C1CADCUL, 0xEA9C227723EE8BCBUL },
+    { 0x0BFACD89EC191EC9UL, 0x92A1958A7675175FUL },
+    { 0xCEF980EC671F667BUL, 0xB749FAED14125D36UL },
+    { 0x82B7E12780E7401AUL, 0xE51C79A85916F484UL },
+    { 0xD1B2ECB8B0908810UL, 0x8F31CC0937AE58D2UL },
+    { 0x861FA7E6DCB4AA15UL, 0xB2FE3F0B8599EF07UL },
+    { 0x67A791E093E1D49AUL, 0xDFBDCECE67006AC9UL },
+    { 0xE0C8BB2C5C6D24E0UL, 0x8BD6A141006042BDUL },
+    { 0x58FAE9F773886E18UL, 0xAECC49914078536DUL },
+    { 0xAF39A475506A899EUL, 0xDA7F5BF590966848UL },
+    { 0x6D8406C952429603UL, 0x888F99797A5E012DUL },
+    { 0xC8E5087BA6D33B83UL, 0xAAB37FD7D8F58178UL },
+    { 0xFB1E4A9A90880A64UL, 0xD5605FCDCF32E1D6UL },
+    { 0x5CF2EEA09A55067FUL, 0x855C3BE0A17FCD26UL },
+    { 0xF42FAA48C0EA481EUL, 0xA6B34AD8C9DFC06FUL },
+    { 0xF13B94DAF124DA26UL, 0xD0601D8EFC57B08BUL },
+    { 0x76C53D08D6B70858UL, 0x823C12795DB6CE57UL },
+    { 0x54768C4B0C64CA6EUL, 0xA2CB1717B52481EDUL },
+    { 0xA9942F5DCF7DFD09UL, 0xCB7DDCDDA26DA268UL },
+    { 0xD3F93B35435D7C4CUL, 0xFE5D54150B090B02UL },
+    { 0xC47BC5014A1A6DAFUL, 0x9EFA548D26E5A6E1UL },
+    { 0x359AB6419CA1091BUL, 0xC6B8E9B0709F109AUL },
+    { 0xC30163D203C94B62UL, 0xF867241C8CC6D4C0UL },
+    { 0x79E0DE63425DCF1DUL, 0x9B407691D7FC44F8UL },
+    { 0x985915FC12F542E4UL, 0xC21094364DFB5636UL },
+    { 0x3E6F5B7B17B2939DUL, 0xF294B943E17A2BC4UL },
+    { 0xA705992CEECF9C42UL, 0x979CF3CA6CEC5B5AUL },
+    { 0x50C6FF782A838353UL, 0xBD8430BD08277231UL },
+    { 0xA4F8BF5635246428UL, 0xECE53CEC4A314EBDUL },
+    { 0x871B7795E136BE99UL, 0x940F4613AE5ED136UL },
+    { 0x28E2557B59846E3FUL, 0xB913179899F68584UL },
+    { 0x331AEADA2FE589CFUL, 0xE757DD7EC07426E5UL },
+    { 0x3FF0D2C85DEF7621UL, 0x9096EA6F3848984FUL },
+    { 0x0FED077A756B53A9UL, 0xB4BCA50B065ABE63UL },
+    { 0xD3E8495912C62894UL, 0xE1EBCE4DC7F16DFBUL },
+    { 0x64712DD7ABBBD95CUL, 0x8D3360F09CF6E4BDUL },
+    { 0xBD8D794D96AACFB3UL, 0xB080392CC4349DECUL },
+    { 0xECF0D7A0FC5583A0UL, 0xDCA04777F541C567UL },
+    { 0xF41686C49DB57244UL, 0x89E42CAAF9491B60UL },
+    { 0x311C2875C522CED5UL, 0xAC5D37D5B79B6239UL },
+    { 0x7D633293366B828BUL, 0xD77485CB25823AC7UL },
+    { 0xAE5DFF9C02033197UL, 0x86A8D39EF77164BCUL },
+    { 0xD9F57F830283FDFCUL, 0xA8530886B54DBDEBUL },
+    { 0xD072DF63C324FD7BUL, 0xD267CAA862A12D66UL },
+    { 0x4247CB9E59F71E6DUL, 0x8380DEA93DA4BC60UL },
+    { 0x52D9BE85F074E608UL, 0xA46116538D0DEB78UL },
+    { 0x67902E276C921F8BUL, 0xCD795BE870516656UL },
+    { 0x00BA1CD8A3DB53B6UL, 0x806BD9714632DFF6UL },
+    { 0x80E8A40ECCD228A4UL, 0xA086CFCD97BF97F3UL },
+    { 0x6122CD128006B2CDUL, 0xC8A883C0FDAF7DF0UL },
+    { 0x796B805720085F81UL, 0xFAD2A4B13D1B5D6CUL },
+    { 0xCBE3303674053BB0UL, 0x9CC3A6EEC6311A63UL },
+    { 0xBEDBFC4411068A9CUL, 0xC3F490AA77BD60FCUL },
+    { 0xEE92FB5515482D44UL, 0xF4F1B4D515ACB93BUL },
+    { 0x751BDD152D4D1C4AUL, 0x991711052D8BF3C5UL },
+    { 0xD262D45A78A0635DUL, 0xBF5CD54678EEF0B6UL },
+    { 0x86FB897116C87C34UL, 0xEF340A98172AACE4UL },
+    { 0xD45D35E6AE3D4DA0UL, 0x9580869F0E7AAC0EUL },
+    { 0x8974836059CCA109UL, 0xBAE0A846D2195712UL },
+    { 0x2BD1A438703FC94BUL, 0xE998D258869FACD7UL },
+    { 0x7B6306A34627DDCFUL, 0x91FF83775423CC06UL },
+    { 0x1A3BC84C17B1D542UL, 0xB67F6455292CBF08UL },
+    { 0x20CABA5F1D9E4A93UL, 0xE41F3D6A7377EECAUL },
+    { 0x547EB47B7282EE9CUL, 0x8E938662882AF53EUL },
+    { 0xE99E619A4F23AA43UL, 0xB23867FB2A35B28DUL },
+    { 0x6405FA00E2EC94D4UL, 0xDEC681F9F4C31F31UL },
+    { 0xDE83BC408DD3DD04UL, 0x8B3C113C38F9F37EUL },
+    { 0x9624AB50B148D445UL, 0xAE0B158B4738705EUL },
+    { 0x3BADD624DD9B0957UL, 0xD98DDAEE19068C76UL },
+    { 0xE54CA5D70A80E5D6UL, 0x87F8A8D4CFA417C9UL },
+    { 0x5E9FCF4CCD211F4CUL, 0xA9F6D30A038D1DBCUL },
+    { 0x7647C3200069671FUL, 0xD47487CC8470652BUL },
+    { 0x29ECD9F40041E073UL, 0x84C8D4DFD2C63F3BUL },
+    { 0xF468107100525890UL, 0xA5FB0A17C777CF09UL },
+    { 0x7182148D4066EEB4UL, 0xCF79CC9DB955C2CCUL },
+    { 0xC6F14CD848405530UL, 0x81AC1FE293D599BFUL },
+    { 0xB8ADA00E5A506A7CUL, 0xA21727DB38CB002FUL },
+    { 0xA6D90811F0E4851CUL, 0xCA9CF1D206FDC03BUL },
+    { 0x908F4A166D1DA663UL, 0xFD442E4688BD304AUL },
+    { 0x9A598E4E043287FEUL, 0x9E4A9CEC15763E2EUL },
+    { 0x40EFF1E1853F29FDUL, 0xC5DD44271AD3CDBAUL },
+    { 0xD12BEE59E68EF47CUL, 0xF7549530E188C128UL },
+    { 0x82BB74F8301958CEUL, 0x9A94DD3E8CF578B9UL },
+    { 0xE36A52363C1FAF01UL, 0xC13A148E3032D6E7UL },
+    { 0xDC44E6C3CB279AC1UL, 0xF18899B1BC3F8CA1UL },
+    { 0x29AB103A5EF8C0B9UL, 0x96F5600F15A7B7E5UL },
+    { 0x7415D448F6B6F0E7UL, 0xBCB2B812DB11A5DEUL },
+    { 0x111B495B3464AD21UL, 0xEBDF661791D60F56UL },
+    { 0xCAB10DD900BEEC34UL, 0x936B9FCEBB25C995UL },
+    { 0x3D5D514F40EEA742UL, 0xB84687C269EF3BFBUL },
+    { 0x0CB4A5A3112A5112UL, 0xE65829B3046B0AFAUL },
+    { 0x47F0E785EABA72ABUL, 0x8FF71A0FE2C2E6DCUL },
+    { 0x59ED216765690F56UL, 0xB3F4E093DB73A093UL },
+    { 0x306869C13EC3532CUL, 0xE0F218B8D25088B8UL },
+    { 0x1E414218C73A13FBUL, 0x8C974F7383725573UL },
+    { 0xE5D1929EF90898FAUL, 0xAFBD2350644EEACFUL },
+    { 0xDF45F746B74ABF39UL, 0xDBAC6C247D62A583UL },
+    { 0x6B8BBA8C328EB783UL, 0x894BC396CE5DA772UL },
+    { 0x066EA92F3F326564UL, 0xAB9EB47C81F5114FUL },
+    { 0xC80A537B0EFEFEBDUL, 0xD686619BA27255A2UL },
+    { 0xBD06742CE95F5F36UL, 0x8613FD0145877585UL },
+    { 0x2C48113823B73704UL, 0xA798FC4196E952E7UL },
+    { 0xF75A15862CA504C5UL, 0xD17F3B51FCA3A7A0UL },
+    { 0x9A984D73DBE722FBUL, 0x82EF85133DE648C4UL },
+    { 0xC13E60D0D2E0EBBAUL, 0xA3AB66580D5FDAF5UL },
+    { 0x318DF905079926A8UL, 0xCC963FEE10B7D1B3UL },
+    { 0xFDF17746497F7052UL, 0xFFBBCFE994E5C61FUL },
+    { 0xFEB6EA8BEDEFA633UL, 0x9FD561F1FD0F9BD3UL },
+    { 0xFE64A52EE96B8FC0UL, 0xC7CABA6E7C5382C8UL },
+    { 0x3DFDCE7AA3C673B0UL, 0xF9BD690A1B68637BUL },
+    { 0x06BEA10CA65C084EUL, 0x9C1661A651213E2DUL },
+    { 0x486E494FCFF30A62UL, 0xC31BFA0FE5698DB8UL },
+    { 0x5A89DBA3C3EFCCFAUL, 0xF3E2F893DEC3F126UL },
+    { 0xF89629465A75E01CUL, 0x986DDB5C6B3A76B7UL },
+    { 0xF6BBB397F1135823UL, 0xBE89523386091465UL },
+    { 0x746AA07DED582E2CUL, 0xEE2BA6C0678B597FUL },
+    { 0xA8C2A44EB4571CDCUL, 0x94DB483840B717EFUL },
+    { 0x92F34D62616CE413UL, 0xBA121A4650E4DDEBUL },
+    { 0x77B020BAF9C81D17UL, 0xE896A0D7E51E1566UL },
+    { 0x0ACE1474DC1D122EUL, 0x915E2486EF32CD60UL },
+    { 0x0D819992132456BAUL, 0xB5B5ADA8AAFF80B8UL },
+    { 0x10E1FFF697ED6C69UL, 0xE3231912D5BF60E6UL },
+    { 0xCA8D3FFA1EF463C1UL, 0x8DF5EFABC5979C8FUL },
+    { 0xBD308FF8A6B17CB2UL, 0xB1736B96B6FD83B3UL },
+    { 0xAC7CB3F6D05DDBDEUL, 0xDDD0467C64BCE4A0UL },
+    { 0x6BCDF07A423AA96BUL, 0x8AA22C0DBEF60EE4UL },
+    { 0x86C16C98D2C953C6UL, 0xAD4AB7112EB3929DUL },
+    { 0xE871C7BF077BA8B7UL, 0xD89D64D57A607744UL },
+    { 0x11471CD764AD4972UL, 0x87625F056C7C4A8BUL },
+    { 0xD598E40D3DD89BCFUL, 0xA93AF6C6C79B5D2DUL },
+    { 0x4AFF1D108D4EC2C3UL, 0xD389B47879823479UL },
+    { 0xCEDF722A585139BAUL, 0x843610CB4BF160CBUL },
+    { 0xC2974EB4EE658828UL, 0xA54394FE1EEDB8FEUL },
+    { 0x733D226229FEEA32UL, 0xCE947A3DA6A9273EUL },
+    { 0x0806357D5A3F525FUL, 0x811CCC668829B887UL },
+    { 0xCA07C2DCB0CF26F7UL, 0xA163FF802A3426A8UL },
+    { 0xFC89B393DD02F0B5UL, 0xC9BCFF6034C13052UL },
+    { 0xBBAC2078D443ACE2UL, 0xFC2C3F3841F17C67UL },
+    { 0xD54B944B84AA4C0DUL, 0x9D9BA7832936EDC0UL },
+    { 0x0A9E795E65D4DF11UL, 0xC5029163F384A931UL },
+    { 0x4D4617B5FF4A16D5UL, 0xF64335BCF065D37DUL },
+    { 0x504BCED1BF8E4E45UL, 0x99EA0196163FA42EUL },
+    { 0xE45EC2862F71E1D6UL, 0xC06481FB9BCF8D39UL },
+    { 0x5D767327BB4E5A4CUL, 0xF07DA27A82C37088UL },
+    { 0x3A6A07F8D510F86FUL, 0x964E858C91BA2655UL },
+    { 0x890489F70A55368BUL, 0xBBE226EFB628AFEAUL },
+    { 0x2B45AC74CCEA842EUL, 0xEADAB0ABA3B2DBE5UL },
+    { 0x3B0B8BC90012929DUL, 0x92C8AE6B464FC96FUL },
+    { 0x09CE6EBB40173744UL, 0xB77ADA0617E3BBCBUL },
+    { 0xCC420A6A101D0515UL, 0xE55990879DDCAABDUL },
+    { 0x9FA946824A12232DUL, 0x8F57FA54C2A9EAB6UL },
+    { 0x47939822DC96ABF9UL, 0xB32DF8E9F3546564UL },
+    { 0x59787E2B93BC56F7UL, 0xDFF9772470297EBDUL },
+    { 0x57EB4EDB3C55B65AUL, 0x8BFBEA76C619EF36UL },
+    { 0xEDE622920B6B23F1UL, 0xAEFAE51477A06B03UL },
+    { 0xE95FAB368E45ECEDUL, 0xDAB99E59958885C4UL },
+    { 0x11DBCB0218EBB414UL, 0x88B402F7FD75539BUL },
+    { 0xD652BDC29F26A119UL, 0xAAE103B5FCD2A881UL },
+    { 0x4BE76D3346F0495FUL, 0xD59944A37C0752A2UL },
+    { 0x6F70A4400C562DDBUL, 0x857FCAE62D8493A5UL },
+    { 0xCB4CCD500F6BB952UL, 0xA6DFBD9FB8E5B88EUL },
+    { 0x7E2000A41346A7A7UL, 0xD097AD07A71F26B2UL },
+    { 0x8ED400668C0C28C8UL, 0x825ECC24C873782FUL },
+    { 0x728900802F0F32FAUL, 0xA2F67F2DFA90563BUL },
+    { 0x4F2B40A03AD2FFB9UL, 0xCBB41EF979346BCAUL },
+    { 0xE2F610C84987BFA8UL, 0xFEA126B7D78186BCUL },
+    { 0x0DD9CA7D2DF4D7C9UL, 0x9F24B832E6B0F436UL },
+    { 0x91503D1C79720DBBUL, 0xC6EDE63FA05D3143UL },
+    { 0x75A44C6397CE912AUL, 0xF8A95FCF88747D94UL },
+    { 0xC986AFBE3EE11ABAUL, 0x9B69DBE1B548CE7CUL },
+    { 0xFBE85BADCE996168UL, 0xC24452DA229B021BUL },
+    { 0xFAE27299423FB9C3UL, 0xF2D56790AB41C2A2UL },
+    { 0xDCCD879FC967D41AUL, 0x97C560BA6B0919A5UL },
+    { 0x5400E987BBC1C920UL, 0xBDB6B8E905CB600FUL },
+    { 0x290123E9AAB23B68UL, 0xED246723473E3813UL },
+    { 0xF9A0B6720AAF6521UL, 0x9436C0760C86E30BUL },
+    { 0xF808E40E8D5B3E69UL, 0xB94470938FA89BCEUL },
+    { 0xB60B1D1230B20E04UL, 0xE7958CB87392C2C2UL },
+    { 0xB1C6F22B5E6F48C2UL, 0x90BD77F3483BB9B9UL },
+    { 0x1E38AEB6360B1AF3UL, 0xB4ECD5F01A4AA828UL },
+    { 0x25C6DA63C38DE1B0UL, 0xE2280B6C20DD5232UL },
+    { 0x579C487E5A38AD0EUL, 0x8D590723948A535FUL },
+    { 0x2D835A9DF0C6D851UL, 0xB0AF48EC79ACE837UL },
+    { 0xF8E431456CF88E65UL, 0xDCDB1B2798182244UL },
+    { 0x1B8E9ECB641B58FFUL, 0x8A08F0F8BF0F156BUL },
+    { 0xE272467E3D222F3FUL, 0xAC8B2D36EED2DAC5UL },
+    { 0x5B0ED81DCC6ABB0FUL, 0xD7ADF884AA879177UL },
+    { 0x98E947129FC2B4E9UL, 0x86CCBB52EA94BAEAUL },
+    { 0x3F2398D747B36224UL, 0xA87FEA27A539E9A5UL },
+    { 0x8EEC7F0D19A03AADUL, 0xD29FE4B18E88640EUL },
+    { 0x1953CF68300424ACUL, 0x83A3EEEEF9153E89UL },
+    { 0x5FA8C3423C052DD7UL, 0xA48CEAAAB75A8E2BUL },
+    { 0x3792F412CB06794DUL, 0xCDB02555653131B6UL },
+    { 0xE2BBD88BBEE40BD0UL, 0x808E17555F3EBF11UL },
+    { 0x5B6ACEAEAE9D0EC4UL, 0xA0B19D2AB70E6ED6UL },
+    { 0xF245825A5A445275UL, 0xC8DE047564D20A8BUL },
+    { 0xEED6E2F0F0D56712UL, 0xFB158592BE068D2EUL },
+    { 0x55464DD69685606BUL, 0x9CED737BB6C4183DUL },
+    { 0xAA97E14C3C26B886UL, 0xC428D05AA4751E4CUL },
+    { 0xD53DD99F4B3066A8UL, 0xF53304714D9265DFUL },
+    { 0xE546A8038EFE4029UL, 0x993FE2C6D07B7FABUL },
+    { 0xDE98520472BDD033UL, 0xBF8FDB78849A5F96UL },
+    { 0x963E66858F6D4440UL, 0xEF73D256A5C0F77CUL },
+    { 0xDDE7001379A44AA8UL, 0x95A8637627989AADUL },
+    { 0x5560C018580D5D52UL, 0xBB127C53B17EC159UL },
+    { 0xAAB8F01E6E10B4A6UL, 0xE9D71B689DDE71AFUL },
+    { 0xCAB3961304CA70E8UL, 0x9226712162AB070DUL },
+    { 0x3D607B97C5FD0D22UL, 0xB6B00D69BB55C8D1UL },
+    { 0x8CB89A7DB77C506AUL, 0xE45C10C42A2B3B05UL },
+    { 0x77F3608E92ADB242UL, 0x8EB98A7A9A5B04E3UL },
+    { 0x55F038B237591ED3UL, 0xB267ED1940F1C61CUL },
+    { 0x6B6C46DEC52F6688UL, 0xDF01E85F912E37A3UL },
+    { 0x2323AC4B3B3DA015UL, 0x8B61313BBABCE2C6UL },
+    { 0xABEC975E0A0D081AUL, 0xAE397D8AA96C1B77UL },
+    { 0x96E7BD358C904A21UL, 0xD9C7DCED53C72255UL },
+    { 0x7E50D64177DA2E54UL, 0x881CEA14545C7575UL },
+    { 0xDDE50BD1D5D0B9E9UL, 0xAA242499697392D2UL },
+    { 0x955E4EC64B44E864UL, 0xD4AD2DBFC3D07787UL },
+    { 0xBD5AF13BEF0B113EUL, 0x84EC3C97DA624AB4UL },
+    { 0xECB1AD8AEACDD58EUL, 0xA6274BBDD0FADD61UL },
+    { 0x67DE18EDA5814AF2UL, 0xCFB11EAD453994BAUL },
+    { 0x80EACF948770CED7UL, 0x81CEB32C4B43FCF4UL },
+    { 0xA1258379A94D028DUL, 0xA2425FF75E14FC31UL },
+    { 0x096EE45813A04330UL, 0xCAD2F7F5359A3B3EUL },
+    { 0x8BCA9D6E188853FCUL, 0xFD87B5F28300CA0DUL },
+    { 0x775EA264CF55347DUL, 0x9E74D1B791E07E48UL },
+    { 0x95364AFE032A819DUL, 0xC612062576589DDAUL },
+    { 0x3A83DDBD83F52204UL, 0xF79687AED3EEC551UL },
+    { 0xC4926A9672793542UL, 0x9ABE14CD44753B52UL },
+    { 0x75B7053C0F178293UL, 0xC16D9A0095928A27UL },
+    { 0x5324C68B12DD6338UL, 0xF1C90080BAF72CB1UL },
+    { 0xD3F6FC16EBCA5E03UL, 0x971DA05074DA7BEEUL },
+    { 0x88F4BB1CA6BCF584UL, 0xBCE5086492111AEAUL },
+    { 0x2B31E9E3D06C32E5UL, 0xEC1E4A7DB69561A5UL },
+    { 0x3AFF322E62439FCFUL, 0x9392EE8E921D5D07UL },
+    { 0x09BEFEB9FAD487C2UL, 0xB877AA3236A4B449UL },
+    { 0x4C2EBE687989A9B3UL, 0xE69594BEC44DE15BUL },
+    { 0x0F9D37014BF60A10UL, 0x901D7CF73AB0ACD9UL },
+    { 0x538484C19EF38C94UL, 0xB424DC35095CD80FUL },
+    { 0x2865A5F206B06FB9UL, 0xE12E13424BB40E13UL },
+    { 0xF93F87B7442E45D3UL, 0x8CBCCC096F5088CBUL },
+    { 0xF78F69A51539D748UL, 0xAFEBFF0BCB24AAFEUL },
+    { 0xB573440E5A884D1BUL, 0xDBE6FECEBDEDD5BEUL },
+    { 0x31680A88F8953030UL, 0x89705F4136B4A597UL },
+    { 0xFDC20D2B36BA7C3DUL, 0xABCC77118461CEFCUL },
+    { 0x3D32907604691B4CUL, 0xD6BF94D5E57A42BCUL },
+    { 0xA63F9A49C2C1B10FUL, 0x8637BD05AF6C69B5UL },
+    { 0x0FCF80DC33721D53UL, 0xA7C5AC471B478423UL },
+    { 0xD3C36113404EA4A8UL, 0xD1B71758E219652BUL },
+    { 0x645A1CAC083126E9UL, 0x83126E978D4FDF3BUL },
+    { 0x3D70A3D70A3D70A3UL, 0xA3D70A3D70A3D70AUL },
+    { 0xCCCCCCCCCCCCCCCCUL, 0xCCCCCCCCCCCCCCCCUL },
+    { 0x0000000000000000UL, 0x8000000000000000UL },
+    { 0x0000000000000000UL, 0xA000000000000000UL },
+    { 0x0000000000000000UL, 0xC800000000000000UL },
+    { 0x0000000000000000UL, 0xFA00000000000000UL },
+    { 0x0000000000000000UL, 0x9C40000000000000UL },
+    { 0x0000000000000000UL, 0xC350000000000000UL },
+    { 0x0000000000000000UL, 0xF424000000000000UL },
+    { 0x0000000000000000UL, 0x9896800000000000UL },
+    { 0x0000000000000000UL, 0xBEBC200000000000UL },
+    { 0x0000000000000000UL, 0xEE6B280000000000UL },
+    { 0x0000000000000000UL, 0x9502F90000000000UL },
+    { 0x0000000000000000UL, 0xBA43B74000000000UL },
+    { 0x0000000000000000UL, 0xE8D4A51000000000UL },
+    { 0x0000000000000000UL, 0x9184E72A00000000UL },
+    { 0x0000000000000000UL, 0xB5E620F480000000UL },
+    { 0x0000000000000000UL, 0xE35FA931A0000000UL },
+    { 0x0000000000000000UL, 0x8E1BC9BF04000000UL },
+    { 0x0000000000000000UL, 0xB1A2BC2EC5000000UL },
+    { 0x0000000000000000UL, 0xDE0B6B3A76400000UL },
+    { 0x0000000000000000UL, 0x8AC7230489E80000UL },
+    { 0x0000000000000000UL, 0xAD78EBC5AC620000UL },
+    { 0x0000000000000000UL, 0xD8D726B7177A8000UL },
+    { 0x0000000000000000UL, 0x878678326EAC9000UL },
+    { 0x0000000000000000UL, 0xA968163F0A57B400UL },
+    { 0x0000000000000000UL, 0xD3C21BCECCEDA100UL },
+    { 0x0000000000000000UL, 0x84595161401484A0UL },
+    { 0x0000000000000000UL, 0xA56FA5B99019A5C8UL },
+    { 0x0000000000000000UL, 0xCECB8F27F4200F3AUL },
+    { 0x4000000000000000UL, 0x813F3978F8940984UL },
+    { 0x5000000000000000UL, 0xA18F07D736B90BE5UL },
+    { 0xA400000000000000UL, 0xC9F2C9CD04674EDEUL },
+    { 0x4D00000000000000UL, 0xFC6F7C4045812296UL },
+    { 0xF020000000000000UL, 0x9DC5ADA82B70B59DUL },
+    { 0x6C28000000000000UL, 0xC5371912364CE305UL },
+    { 0xC732000000000000UL, 0xF684DF56C3E01BC6UL },
+    { 0x3C7F400000000000UL, 0x9A130B963A6C115CUL },
+    { 0x4B9F100000000000UL, 0xC097CE7BC90715B3UL },
+    { 0x1E86D40000000000UL, 0xF0BDC21ABB48DB20UL },
+    { 0x1314448000000000UL, 0x96769950B50D88F4UL },
+    { 0x17D955A000000000UL, 0xBC143FA4E250EB31UL },
+    { 0x5DCFAB0800000000UL, 0xEB194F8E1AE525FDUL },
+    { 0x5AA1CAE500000000UL, 0x92EFD1B8D0CF37BEUL },
+    { 0xF14A3D9E40000000UL, 0xB7ABC627050305ADUL },
+    { 0x6D9CCD05D0000000UL, 0xE596B7B0C643C719UL },
+    { 0xE4820023A2000000UL, 0x8F7E32CE7BEA5C6FUL },
+    { 0xDDA2802C8A800000UL, 0xB35DBF821AE4F38BUL },
+    { 0xD50B2037AD200000UL, 0xE0352F62A19E306EUL },
+    { 0x4526F422CC340000UL, 0x8C213D9DA502DE45UL },
+    { 0x9670B12B7F410000UL, 0xAF298D050E4395D6UL },
+    { 0x3C0CDD765F114000UL, 0xDAF3F04651D47B4CUL },
+    { 0xA5880A69FB6AC800UL, 0x88D8762BF324CD0FUL },
+    { 0x8EEA0D047A457A00UL, 0xAB0E93B6EFEE0053UL },
+    { 0x72A4904598D6D880UL, 0xD5D238A4ABE98068UL },
+    { 0x47A6DA2B7F864750UL, 0x85A36366EB71F041UL },
+    { 0x999090B65F67D924UL, 0xA70C3C40A64E6C51UL },
+    { 0xFFF4B4E3F741CF6DUL, 0xD0CF4B50CFE20765UL },
+    { 0xBFF8F10E7A8921A4UL, 0x82818F1281ED449FUL },
+    { 0xAFF72D52192B6A0DUL, 0xA321F2D7226895C7UL },
+    { 0x9BF4F8A69F764490UL, 0xCBEA6F8CEB02BB39UL },
+    { 0x02F236D04753D5B4UL, 0xFEE50B7025C36A08UL },
+    { 0x01D762422C946590UL, 0x9F4F2726179A2245UL },
+    { 0x424D3AD2B7B97EF5UL, 0xC722F0EF9D80AAD6UL },
+    { 0xD2E0898765A7DEB2UL, 0xF8EBAD2B84E0D58BUL },
+    { 0x63CC55F49F88EB2FUL, 0x9B934C3B330C8577UL },
+    { 0x3CBF6B71C76B25FBUL, 0xC2781F49FFCFA6D5UL },
+    { 0x8BEF464E3945EF7AUL, 0xF316271C7FC3908AUL },
+    { 0x97758BF0E3CBB5ACUL, 0x97EDD871CFDA3A56UL },
+    { 0x3D52EEED1CBEA317UL, 0xBDE94E8E43D0C8ECUL },
+    { 0x4CA7AAA863EE4BDDUL, 0xED63A231D4C4FB27UL },
+    { 0x8FE8CAA93E74EF6AUL, 0x945E455F24FB1CF8UL },
+    { 0xB3E2FD538E122B44UL, 0xB975D6B6EE39E436UL },
+    { 0x60DBBCA87196B616UL, 0xE7D34C64A9C85D44UL },
+    { 0xBC8955E946FE31CDUL, 0x90E40FBEEA1D3A4AUL },
+    { 0x6BABAB6398BDBE41UL, 0xB51D13AEA4A488DDUL },
+    { 0xC696963C7EED2DD1UL, 0xE264589A4DCDAB14UL },
+    { 0xFC1E1DE5CF543CA2UL, 0x8D7EB76070A08AECUL },
+    { 0x3B25A55F43294BCBUL, 0xB0DE65388CC8ADA8UL },
+    { 0x49EF0EB713F39EBEUL, 0xDD15FE86AFFAD912UL },
+    { 0x6E3569326C784337UL, 0x8A2DBF142DFCC7ABUL },
+    { 0x49C2C37F07965404UL, 0xACB92ED9397BF996UL },
+    { 0xDC33745EC97BE906UL, 0xD7E77A8F87DAF7FBUL },
+    { 0x69A028BB3DED71A3UL, 0x86F0AC99B4E8DAFDUL },
+    { 0xC40832EA0D68CE0CUL, 0xA8ACD7C0222311BCUL },
+    { 0xF50A3FA490C30190UL, 0xD2D80DB02AABD62BUL },
+    { 0x792667C6DA79E0FAUL, 0x83C7088E1AAB65DBUL },
+    { 0x577001B891185938UL, 0xA4B8CAB1A1563F52UL },
+    { 0xED4C0226B55E6F86UL, 0xCDE6FD5E09ABCF26UL },
+    { 0x544F8158315B05B4UL, 0x80B05E5AC60B6178UL },
+    { 0x696361AE3DB1C721UL, 0xA0DC75F1778E39D6UL },
+    { 0x03BC3A19CD1E38E9UL, 0xC913936DD571C84CUL },
+    { 0x04AB48A04065C723UL, 0xFB5878494ACE3A5FUL },
+    { 0x62EB0D64283F9C76UL, 0x9D174B2DCEC0E47BUL },
+    { 0x3BA5D0BD324F8394UL, 0xC45D1DF942711D9AUL },
+    { 0xCA8F44EC7EE36479UL, 0xF5746577930D6500UL },
+    { 0x7E998B13CF4E1ECBUL, 0x9968BF6ABBE85F20UL },
+    { 0x9E3FEDD8C321A67EUL, 0xBFC2EF456AE276E8UL },
+    { 0xC5CFE94EF3EA101EUL, 0xEFB3AB16C59B14A2UL },
+    { 0xBBA1F1D158724A12UL, 0x95D04AEE3B80ECE5UL },
+    { 0x2A8A6E45AE8EDC97UL, 0xBB445DA9CA61281FUL },
+    { 0xF52D09D71A3293BDUL, 0xEA1575143CF97226UL },
+    { 0x593C2626705F9C56UL, 0x924D692CA61BE758UL },
+    { 0x6F8B2FB00C77836CUL, 0xB6E0C377CFA2E12EUL },
+    { 0x0B6DFB9C0F956447UL, 0xE498F455C38B997AUL },
+    { 0x4724BD4189BD5EACUL, 0x8EDF98B59A373FECUL },
+    { 0x58EDEC91EC2CB657UL, 0xB2977EE300C50FE7UL },
+    { 0x2F2967B66737E3EDUL, 0xDF3D5E9BC0F653E1UL },
+    { 0xBD79E0D20082EE74UL, 0x8B865B215899F46CUL },
+    { 0xECD8590680A3AA11UL, 0xAE67F1E9AEC07187UL },
+    { 0xE80E6F4820CC9495UL, 0xDA01EE641A708DE9UL },
+    { 0x3109058D147FDCDDUL, 0x884134FE908658B2UL },
+    { 0xBD4B46F0599FD415UL, 0xAA51823E34A7EEDEUL },
+    { 0x6C9E18AC7007C91AUL, 0xD4E5E2CDC1D1EA96UL },
+    { 0x03E2CF6BC604DDB0UL, 0x850FADC09923329EUL },
+    { 0x84DB8346B786151CUL, 0xA6539930BF6BFF45UL },
+    { 0xE612641865679A63UL, 0xCFE87F7CEF46FF16UL },
+    { 0x4FCB7E8F3F60C07EUL, 0x81F14FAE158C5F6EUL },
+    { 0xE3BE5E330F38F09DUL, 0xA26DA3999AEF7749UL },
+    { 0x5CADF5BFD3072CC5UL, 0xCB090C8001AB551CUL },
+    { 0x73D9732FC7C8F7F6UL, 0xFDCB4FA002162A63UL },
+    { 0x2867E7FDDCDD9AFAUL, 0x9E9F11C4014DDA7EUL },
+    { 0xB281E1FD541501B8UL, 0xC646D63501A1511DUL },
+    { 0x1F225A7CA91A4226UL, 0xF7D88BC24209A565UL },
+    { 0x3375788DE9B06958UL, 0x9AE757596946075FUL },
+    { 0x0052D6B1641C83AEUL, 0xC1A12D2FC3978937UL },
+    { 0xC0678C5DBD23A49AUL, 0xF209787BB47D6B84UL },
+    { 0xF840B7BA963646E0UL, 0x9745EB4D50CE6332UL },
+    { 0xB650E5A93BC3D898UL, 0xBD176620A501FBFFUL },
+    { 0xA3E51F138AB4CEBEUL, 0xEC5D3FA8CE427AFFUL },
+    { 0xC66F336C36B10137UL, 0x93BA47C980E98CDFUL },
+    { 0xB80B0047445D4184UL, 0xB8A8D9BBE123F017UL },
+    { 0xA60DC059157491E5UL, 0xE6D3102AD96CEC1DUL },
+    { 0x87C89837AD68DB2FUL, 0x9043EA1AC7E41392UL },
+    { 0x29BABE4598C311FBUL, 0xB454E4A179DD1877UL },
+    { 0xF4296DD6FEF3D67AUL, 0xE16A1DC9D8545E94UL },
+    { 0x1899E4A65F58660CUL, 0x8CE2529E2734BB1DUL },
+    { 0x5EC05DCFF72E7F8FUL, 0xB01AE745B101E9E4UL },
+    { 0x76707543F4FA1F73UL, 0xDC21A1171D42645DUL },
+    { 0x6A06494A791C53A8UL, 0x899504AE72497EBAUL },
+    { 0x0487DB9D17636892UL, 0xABFA45DA0EDBDE69UL },
+    { 0x45A9D2845D3C42B6UL, 0xD6F8D7509292D603UL },
+    { 0x0B8A2392BA45A9B2UL, 0x865B86925B9BC5C2UL },
+    { 0x8E6CAC7768D7141EUL, 0xA7F26836F282B732UL },
+    { 0x3207D795430CD926UL, 0xD1EF0244AF2364FFUL },
+    { 0x7F44E6BD49E807B8UL, 0x8335616AED761F1FUL },
+    { 0x5F16206C9C6209A6UL, 0xA402B9C5A8D3A6E7UL },
+    { 0x36DBA887C37A8C0FUL, 0xCD036837130890A1UL },
+    { 0xC2494954DA2C9789UL, 0x802221226BE55A64UL },
+    { 0xF2DB9BAA10B7BD6CUL, 0xA02AA96B06DEB0FDUL },
+    { 0x6F92829494E5ACC7UL, 0xC83553C5C8965D3DUL },
+    { 0xCB772339BA1F17F9UL, 0xFA42A8B73ABBF48CUL },
+    { 0xFF2A760414536EFBUL, 0x9C69A97284B578D7UL },
+    { 0xFEF5138519684ABAUL, 0xC38413CF25E2D70DUL },
+    { 0x7EB258665FC25D69UL, 0xF46518C2EF5B8CD1UL },
+    { 0xEF2F773FFBD97A61UL, 0x98BF2F79D5993802UL },
+    { 0xAAFB550FFACFD8FAUL, 0xBEEEFB584AFF8603UL },
+    { 0x95BA2A53F983CF38UL, 0xEEAABA2E5DBF6784UL },
+    { 0xDD945A747BF26183UL, 0x952AB45CFA97A0B2UL },
+    { 0x94F971119AEEF9E4UL, 0xBA756174393D88DFUL },
+    { 0x7A37CD5601AAB85DUL, 0xE912B9D1478CEB17UL },
+    { 0xAC62E055C10AB33AUL, 0x91ABB422CCB812EEUL },
+    { 0x577B986B314D6009UL, 0xB616A12B7FE617AAUL },
+    { 0xED5A7E85FDA0B80BUL, 0xE39C49765FDF9D94UL },
+    { 0x14588F13BE847307UL, 0x8E41ADE9FBEBC27DUL },
+    { 0x596EB2D8AE258FC8UL, 0xB1D219647AE6B31CUL },
+    { 0x6FCA5F8ED9AEF3BBUL, 0xDE469FBD99A05FE3UL },
+    { 0x25DE7BB9480D5854UL, 0x8AEC23D680043BEEUL },
+    { 0xAF561AA79A10AE6AUL, 0xADA72CCC20054AE9UL },
+    { 0x1B2BA1518094DA04UL, 0xD910F7FF28069DA4UL },
+    { 0x90FB44D2F05D0842UL, 0x87AA9AFF79042286UL },
+    { 0x353A1607AC744A53UL, 0xA99541BF57452B28UL },
+    { 0x42889B8997915CE8UL, 0xD3FA922F2D1675F2UL },
+    { 0x69956135FEBADA11UL, 0x847C9B5D7C2E09B7UL },
+    { 0x43FAB9837E699095UL, 0xA59BC234DB398C25UL },
+    { 0x94F967E45E03F4BBUL, 0xCF02B2C21207EF2EUL },
+    { 0x1D1BE0EEBAC278F5UL, 0x8161AFB94B44F57DUL },
+    { 0x6462D92A69731732UL, 0xA1BA1BA79E1632DCUL },
+    { 0x7D7B8F7503CFDCFEUL, 0xCA28A291859BBF93UL },
+    { 0x5CDA735244C3D43EUL, 0xFCB2CB35E702AF78UL },
+    { 0x3A0888136AFA64A7UL, 0x9DEFBF01B061ADABUL },
+    { 0x088AAA1845B8FDD0UL, 0xC56BAEC21C7A1916UL },
+    { 0x8AAD549E57273D45UL, 0xF6C69A72A3989F5BUL },
+    { 0x36AC54E2F678864BUL, 0x9A3C2087A63F6399UL },
+    { 0x84576A1BB416A7DDUL, 0xC0CB28A98FCF3C7FUL },
+    { 0x656D44A2A11C51D5UL, 0xF0FDF2D3F3C30B9FUL },
+    { 0x9F644AE5A4B1B325UL, 0x969EB7C47859E743UL },
+    { 0x873D5D9F0DDE1FEEUL, 0xBC4665B596706114UL },
+    { 0xA90CB506D155A7EAUL, 0xEB57FF22FC0C7959UL },
+    { 0x09A7F12442D588F2UL, 0x9316FF75DD87CBD8UL },
+    { 0x0C11ED6D538AEB2FUL, 0xB7DCBF5354E9BECEUL },
+    { 0x8F1668C8A86DA5FAUL, 0xE5D3EF282A242E81UL },
+    { 0xF96E017D694487BCUL, 0x8FA475791A569D10UL },
+    { 0x37C981DCC395A9ACUL, 0xB38D92D760EC4455UL },
+    { 0x85BBE253F47B1417UL, 0xE070F78D3927556AUL },
+    { 0x93956D7478CCEC8EUL, 0x8C469AB843B89562UL },
+    { 0x387AC8D1970027B2UL, 0xAF58416654A6BABBUL },
+    { 0x06997B05FCC0319EUL, 0xDB2E51BFE9D0696AUL },
+    { 0x441FECE3BDF81F03UL, 0x88FCF317F22241E2UL },
+    { 0xD527E81CAD7626C3UL, 0xAB3C2FDDEEAAD25AUL },
+    { 0x8A71E223D8D3B074UL, 0xD60B3BD56A5586F1UL },
+    { 0xF6872D5667844E49UL, 0x85C7056562757456UL },
+    { 0xB428F8AC016561DBUL, 0xA738C6BEBB12D16CUL },
+    { 0xE13336D701BEBA52UL, 0xD106F86E69D785C7UL },
+    { 0xECC0024661173473UL, 0x82A45B450226B39CUL },
+    { 0x27F002D7F95D0190UL, 0xA34D721642B06084UL },
+    { 0x31EC038DF7B441F4UL, 0xCC20CE9BD35C78A5UL },
+    { 0x7E67047175A15271UL, 0xFF290242C83396CEUL },
+    { 0x0F0062C6E984D386UL, 0x9F79A169BD203E41UL },
+    { 0x52C07B78A3E60868UL, 0xC75809C42C684DD1UL },
+    { 0xA7709A56CCDF8A82UL, 0xF92E0C3537826145UL },
+    { 0x88A66076400BB691UL, 0x9BBCC7A142B17CCBUL },
+    { 0x6ACFF893D00EA435UL, 0xC2ABF989935DDBFEUL },
+    { 0x0583F6B8C4124D43UL, 0xF356F7EBF83552FEUL },
+    { 0xC3727A337A8B704AUL, 0x98165AF37B2153DEUL },
+    { 0x744F18C0592E4C5CUL, 0xBE1BF1B059E9A8D6UL },
+    { 0x1162DEF06F79DF73UL, 0xEDA2EE1C7064130CUL },
+    { 0x8ADDCB5645AC2BA8UL, 0x9485D4D1C63E8BE7UL },
+    { 0x6D953E2BD7173692UL, 0xB9A74A0637CE2EE1UL },
+    { 0xC8FA8DB6CCDD0437UL, 0xE8111C87C5C1BA99UL },
+    { 0x1D9C9892400A22A2UL, 0x910AB1D4DB9914A0UL },
+    { 0x2503BEB6D00CAB4BUL, 0xB54D5E4A127F59C8UL },
+    { 0x2E44AE64840FD61DUL, 0xE2A0B5DC971F303AUL },
+    { 0x5CEAECFED289E5D2UL, 0x8DA471A9DE737E24UL },
+    { 0x7425A83E872C5F47UL, 0xB10D8E1456105DADUL },
+    { 0xD12F124E28F77719UL, 0xDD50F1996B947518UL },
+    { 0x82BD6B70D99AAA6FUL, 0x8A5296FFE33CC92FUL },
+    { 0x636CC64D1001550BUL, 0xACE73CBFDC0BFB7BUL },
+    { 0x3C47F7E05401AA4EUL, 0xD8210BEFD30EFA5AUL },
+    { 0x65ACFAEC34810A71UL, 0x8714A775E3E95C78UL },
+    { 0x7F1839A741A14D0DUL, 0xA8D9D1535CE3B396UL },
+    { 0x1EDE48111209A050UL, 0xD31045A8341CA07CUL },
+    { 0x934AED0AAB460432UL, 0x83EA2B892091E44DUL },
+    { 0xF81DA84D5617853FUL, 0xA4E4B66B68B65D60UL },
+    { 0x36251260AB9D668EUL, 0xCE1DE40642E3F4B9UL },
+    { 0xC1D72B7C6B426019UL, 0x80D2AE83E9CE78F3UL },
+    { 0xB24CF65B8612F81FUL, 0xA1075A24E4421730UL },
+    { 0xDEE033F26797B627UL, 0xC94930AE1D529CFCUL },
+    { 0x169840EF017DA3B1UL, 0xFB9B7CD9A4A7443CUL },
+    { 0x8E1F289560EE864EUL, 0x9D412E0806E88AA5UL },
+    { 0xF1A6F2BAB92A27E2UL, 0xC491798A08A2AD4EUL },
+    { 0xAE10AF696774B1DBUL, 0xF5B5D7EC8ACB58A2UL },
+    { 0xACCA6DA1E0A8EF29UL, 0x9991A6F3D6BF1765UL },
+    { 0x17FD090A58D32AF3UL, 0xBFF610B0CC6EDD3FUL },
+    { 0xDDFC4B4CEF07F5B0UL, 0xEFF394DCFF8A948EUL },
+    { 0x4ABDAF101564F98EUL, 0x95F83D0A1FB69CD9UL },
+    { 0x9D6D1AD41ABE37F1UL, 0xBB764C4CA7A4440FUL },
+    { 0x84C86189216DC5EDUL, 0xEA53DF5FD18D5513UL },
+    { 0x32FD3CF5B4E49BB4UL, 0x92746B9BE2F8552CUL },
+    { 0x3FBC8C33221DC2A1UL, 0xB7118682DBB66A77UL },
+    { 0x0FABAF3FEAA5334AUL, 0xE4D5E82392A40515UL },
+    { 0x29CB4D87F2A7400EUL, 0x8F05B1163BA6832DUL },
+    { 0x743E20E9EF511012UL, 0xB2C71D5BCA9023F8UL },
+    { 0x914DA9246B255416UL, 0xDF78E4B2BD342CF6UL },
+    { 0x1AD089B6C2F7548EUL, 0x8BAB8EEFB6409C1AUL },
+    { 0xA184AC2473B529B1UL, 0xAE9672ABA3D0C320UL },
+    { 0xC9E5D72D90A2741EUL, 0xDA3C0F568CC4F3E8UL },
+    { 0x7E2FA67C7A658892UL, 0x8865899617FB1871UL },
+    { 0xDDBB901B98FEEAB7UL, 0xAA7EEBFB9DF9DE8DUL },
+    { 0x552A74227F3EA565UL, 0xD51EA6FA85785631UL },
+    { 0xD53A88958F87275FUL, 0x8533285C936B35DEUL },
+    { 0x8A892ABAF368F137UL, 0xA67FF273B8460356UL },
+    { 0x2D2B7569B0432D85UL, 0xD01FEF10A657842CUL },
+    { 0x9C3B29620E29FC73UL, 0x8213F56A67F6B29BUL },
+    { 0x8349F3BA91B47B8FUL, 0xA298F2C501F45F42UL },
+    { 0x241C70A936219A73UL, 0xCB3F2F7642717713UL },
+    { 0xED238CD383AA0110UL, 0xFE0EFB53D30DD4D7UL },
+    { 0xF4363804324A40AAUL, 0x9EC95D1463E8A506UL },
+    { 0xB143C6053EDCD0D5UL, 0xC67BB4597CE2CE48UL },
+    { 0xDD94B7868E94050AUL, 0xF81AA16FDC1B81DAUL },
+    { 0xCA7CF2B4191C8326UL, 0x9B10A4E5E9913128UL },
+    { 0xFD1C2F611F63A3F0UL, 0xC1D4CE1F63F57D72UL },
+    { 0xBC633B39673C8CECUL, 0xF24A01A73CF2DCCFUL },
+    { 0xD5BE0503E085D813UL, 0x976E41088617CA01UL },
+    { 0x4B2D8644D8A74E18UL, 0xBD49D14AA79DBC82UL },
+    { 0xDDF8E7D60ED1219EUL, 0xEC9C459D51852BA2UL },
+    { 0xCABB90E5C942B503UL, 0x93E1AB8252F33B45UL },
+    { 0x3D6A751F3B936243UL, 0xB8DA1662E7B00A17UL },
+    { 0x0CC512670A783AD4UL, 0xE7109BFBA19C0C9DUL },
+    { 0x27FB2B80668B24C5UL, 0x906A617D450187E2UL },
+    { 0xB1F9F660802DEDF6UL, 0xB484F9DC9641E9DAUL },
+    { 0x5E7873F8A0396973UL, 0xE1A63853BBD26451UL },
+    { 0xDB0B487B6423E1E8UL, 0x8D07E33455637EB2UL },
+    { 0x91CE1A9A3D2CDA62UL, 0xB049DC016ABC5E5FUL },
+    { 0x7641A140CC7810FBUL, 0xDC5C5301C56B75F7UL },
+    { 0xA9E904C87FCB0A9DUL, 0x89B9B3E11B6329BAUL },
+    { 0x546345FA9FBDCD44UL, 0xAC2820D9623BF429UL },
+    { 0xA97C177947AD4095UL, 0xD732290FBACAF133UL },
+    { 0x49ED8EABCCCC485DUL, 0x867F59A9D4BED6C0UL },
+    { 0x5C68F256BFFF5A74UL, 0xA81F301449EE8C70UL },
+    { 0x73832EEC6FFF3111UL, 0xD226FC195C6A2F8CUL },
+    { 0xC831FD53C5FF7EABUL, 0x83585D8FD9C25DB7UL },
+    { 0xBA3E7CA8B77F5E55UL, 0xA42E74F3D032F525UL },
+    { 0x28CE1BD2E55F35EBUL, 0xCD3A1230C43FB26FUL },
+    { 0x7980D163CF5B81B3UL, 0x80444B5E7AA7CF85UL },
+    { 0xD7E105BCC332621FUL, 0xA0555E361951C366UL },
+    { 0x8DD9472BF3FEFAA7UL, 0xC86AB5C39FA63440UL },
+    { 0xB14F98F6F0FEB951UL, 0xFA856334878FC150UL },
+    { 0x6ED1BF9A569F33D3UL, 0x9C935E00D4B9D8D2UL },
+    { 0x0A862F80EC4700C8UL, 0xC3B8358109E84F07UL },
+    { 0xCD27BB612758C0FAUL, 0xF4A642E14C6262C8UL },
+    { 0x8038D51CB897789CUL, 0x98E7E9CCCFBD7DBDUL },
+    { 0xE0470A63E6BD56C3UL, 0xBF21E44003ACDD2CUL },
+    { 0x1858CCFCE06CAC74UL, 0xEEEA5D5004981478UL },
+    { 0x0F37801E0C43EBC8UL, 0x95527A5202DF0CCBUL },
+    { 0xD30560258F54E6BAUL, 0xBAA718E68396CFFDUL },
+    { 0x47C6B82EF32A2069UL, 0xE950DF20247C83FDUL },
+    { 0x4CDC331D57FA5441UL, 0x91D28B7416CDD27EUL },
+    { 0xE0133FE4ADF8E952UL, 0xB6472E511C81471DUL },
+    { 0x58180FDDD97723A6UL, 0xE3D8F9E563A198E5UL },
+    { 0x570F09EAA7EA7648UL, 0x8E679C2F5E44FF8FUL }
+};
+
+/* full 128 bit product of two 64 bit numbers */
+static void multiply_wide(const unsigned long a, const unsigned long b, unsigned long * const high, unsigned long * const low)
+{
+    unsigned long a_low = a & 0xFFFFFFFFUL;
+    unsigned long a_high = a >> 32;
+    unsigned long b_low = b & 0xFFFFFFFFUL;
+    unsigned long b_high = b >> 32;
+    unsigned long low_low = a_low * b_low;
+    unsigned long high_low = a_high * b_low;
+    unsigned long low_high = a_low * b_high;
+    unsigned long middle = (low_low >> 32) + (high_low & 0xFFFFFFFFUL) + low_high;
+
+    *low = (middle << 32) | (low_low & 0xFFFFFFFFUL);
+    *high = (a_high * b_high) + (high_low >> 32) + (middle >> 32);
+}
+
+/* floor(value / 2^16) without relying on the implementation defined shift of negative numbers */
+static long floor_shift16(const long value)
+{
+    if (value >= 0)
+    {
+        return value >> 16;
+    }
+
+    return -((-value + 65535) >> 16);
+}
+
+/* mantissa * 10^exponent correctly rounded, mantissa must not be 0.
+ * Returns false when the result is ambiguous, subnormal or out of range, strtod has to decide then. */
+static cJSON_bool eisel_lemire(unsigned long mantissa, const long exponent, double * const number)
+{
+    const unsigned long *power = NULL;
+    unsigned long x_high = 0;
+    unsigned long x_low = 0;
+    unsigned long y_high = 0;
+    unsigned long y_low = 0;
+    unsigned long result_mantissa = 0;
+    unsigned long result_exponent = 0;
+    unsigned long bits = 0;
+    unsigned long msb = 0;
+    int leading_zeros = 0;
+
+    if ((exponent < LEMIRE_POWER_MIN) || (exponent > LEMIRE_POWER_MAX))
+    {
+        return false;
+    }
+    power = lemire_powers_of_ten[exponent - LEMIRE_POWER_MIN];
+
+    /* normalize, the binary exponent estimate is floor(exponent * log2(10)) */
+    while (!(mantissa & 0x8000000000000000UL))
+    {
+        mantissa <<= 1;
+        leading_zeros++;
+    }
+    result_exponent = (unsigned long)(floor_shift16(217706L * exponent) + 64 + 1023 - leading_zeros);
+
+    multiply_wide(mantissa, power[1], &x_high, &x_low);
+    /* the truncated power may have lost a carry into the bits that decide the rounding */
+    if (((x_high & 0x1FF) == 0x1FF) && ((x_low + mantissa) < mantissa))
+    {
+        unsigned long merged_high = x_high;
+        unsigned long merged_low = 0;
+        multiply_wide(mantissa, power[0], &y_high, &y_low);
+        merged_low = x_low + y_high;
+        if (merged_low < x_low)
+        {
+            merged_high++;
+        }
+        if (((merged_high & 0x1FF) == 0x1FF) && ((merged_low + 1) == 0) && ((y_low + mantissa) < mantissa))
+        {
+            return false;
+        }
+        x_high = merged_high;
+        x_low = merged_low;
+    }
+
+    /* keep 54 bits, the last one decides the rounding */
+    msb = x_high >> 63;
+    result_mantissa = x_high >> (msb + 9);
+    result_exponent -= 1 ^ msb;
+
+    /* exactly halfway between two doubles */
+    if ((x_low == 0) && ((x_high & 0x1FF) == 0) && ((result_mantissa & 3) == 1))
+    {
+        return false;
+    }
+
+    result_mantissa += result_mantissa & 1;
+    result_mantissa >>= 1;
+    if ((result_mantissa >> 53) > 0)
+    {
+        result_mantissa >>= 1;
+        result_exponent++;
+    }
+
+    /* subnormal, infinite or below zero (wrapped around) */
+    if ((result_exponent - 1) >= (0x7FF - 1))
+    {
+        return false;
+    }
+
+    bits = (result_exponent << 52) | (result_mantissa & 0x000FFFFFFFFFFFFFUL);
+    memcpy(number, &bits, sizeof(*number));
+
+    return true;
+}
+#endif
+
+/* mantissa * 10^exponent correctly rounded without strtod, false when that isn't possible */
+static cJSON_bool decimal_to_double(const unsigned long mantissa, const long exponent, double * const number)
+{
+    if (mantissa == 0)
+    {
+        *number = 0;
+        return true;
+    }
+#ifdef CJSON_FAST_NUMBERS
+    /* mantissa < 2^53 converts to double exactly, the shift is split for 32 bit longs */
+    if ((((mantissa >> 26) >> 27) == 0) && (exponent >= -EXACT_POWER_MAX) && (exponent <= EXACT_POWER_MAX))
+    {
+        *number = (double)mantissa;
+        if (exponent > 0)
+        {
+            *number *= exact_powers_of_ten[exponent];
+        }
+        else if (exponent < 0)
+        {
+            *number /= exact_powers_of_ten[-exponent];
+        }
+        return true;
+    }
+#endif
+#ifdef CJSON_64BIT_DOUBLES
+    return eisel_lemire(mantissa, exponent, number);
+#else
+    return false;
+#endif
+}
+
+/* convert the number text in [start, end) with strtod, used when the fast path can't give an exact result */
+static cJSON_bool strtod_number(const parse_buffer * const input_buffer, const unsigned char * const start, const size_t length, double * const number, size_t * const consumed)
+{
+    unsigned char *after_end = NULL;
+    unsigned char local_c_string[64];
+    unsigned char *number_c_string = local_c_string;
     unsigned char decimal_point = get_decimal_point();
-    double test = 0.0;
+    size_t i = 0;
+
+    if (length >= sizeof(local_c_string))
+    {
+        number_c_string = (unsigned char*)parse_allocate(input_buffer, length + sizeof(""));
+        if (number_c_string == NULL)
+        {
+            return false;
+        }
+    }
+
+    /* replace '.' with the decimal point of the current locale (for strtod)
+     * This also takes care of '\0' not necessarily being available for marking the end of the input */
+    for (i = 0; i < length; i++)
+    {
+        number_c_string[i] = (start[i] == '.') ? decimal_point : start[i];
+    }
+    number_c_string[length] = '\0';
+
+    *number = strtod((const char*)number_c_string, (char**)&after_end);
+    *consumed = (size_t)(after_end - number_c_string);
+
+    if (number_c_string != local_c_string)
+    {
+        parse_deallocate(input_buffer, number_c_string);
+    }
+
+    return *consumed != 0;
+}
+
+/* Parse the input text to generate a number, and populate the result into item.
+ * The text is scanned in place with the grammar strtod accepts for these characters. The digits are collected
+ * into an integer mantissa and decimal exponent, converted exactly where possible and by strtod otherwise. */
+static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
+{
+    double number = 0;
+    unsigned long mantissa = 0;
+    long exponent = 0; /* decimal exponent applied to the mantissa */
+    long exponent_value = 0;
+    cJSON_bool negative = false;
+    cJSON_bool exponent_negative = false;
+    cJSON_bool exact = true; /* all significant digits are in the mantissa */
+    cJSON_bool converted = false;
+    size_t digits = 0;
+    size_t length = 0;
+    const unsigned char *start = NULL;
+    const unsigned char *pointer = NULL;
+    const unsigned char *end = NULL;
+    const unsigned char *exponent_pointer = NULL;
+
+    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+    {
+        return false;
+    }
+
+    start = buffer_at_offset(input_buffer);
+    end = input_buffer->content + input_buffer->length;
+    pointer = start;
+
+    if ((pointer < end) && ((*pointer == '-') || (*pointer == '+')))
+    {
+        negative = (*pointer == '-');
+        pointer++;
+    }
+
+    /* integer part, digits that don't fit only scale the mantissa */
+    for (; (pointer < end) && (*pointer >= '0') && (*pointer <= '9'); pointer++, digits++)
+    {
+        if (mantissa <= ((ULONG_MAX - 9) / 10))
+        {
+            mantissa = (mantissa * 10) + (unsigned long)(*pointer - '0');
+        }
+        else
+        {
+            exact = exact && (*pointer == '0');
+            exponent++;
+        }
+    }
+
+    /* fraction part, digits that don't fit are dropped */
+    if ((pointer < end) && (*pointer == '.'))
+    {
+        for (pointer++; (pointer < end) && (*pointer >= '0') && (*pointer <= '9'); pointer++, digits++)
+        {
+            if (mantissa <= ((ULONG_MAX - 9) / 10))
+            {
+                mantissa = (mantissa * 10) + (unsigned long)(*pointer - '0');
+                exponent--;
+            }
+            else
+            {
+                exact = exact && (*pointer == '0');
+            }
+        }
+    }
+
+    if (digits == 0)
+    {
+        return false; /* parse_error */
+    }
+
+    /* the exponent only belongs to the number if it has digits */
+    if ((pointer < end) && ((*pointer == 'e') || (*pointer == 'E')))
+    {
+        exponent_pointer = pointer + 1;
+        if ((exponent_pointer < end) && ((*exponent_pointer == '-') || (*exponent_pointer == '+')))
+        {
+            exponent_negative = (*exponent_pointer == '-');
+            exponent_pointer++;
+        }
+        if ((exponent_pointer < end) && (*exponent_pointer >= '0') && (*exponent_pointer <= '9'))
+        {
+            for (pointer = exponent_pointer; (pointer < end) && (*pointer >= '0') && (*pointer <= '9'); pointer++)
+            {
+                /* saturate, anything this large over- or underflows anyway */
+                if (exponent_value < 100000)
+                {
+                    exponent_value = (exponent_value * 10) + (*pointer - '0');
+                }
+            }
+            exponent += exponent_negative ? -exponent_value : exponent_value;
+        }
+    }
+    length = (size_t)(pointer - start);
+
+    if (exact)
+    {
+        converted = decimal_to_double(mantissa, exponent, &number);
+    }
+
+    if (converted)
+    {
+        if (negative)
+        {
+            number = -number;
+        }
+    }
+    else if (!strtod_number(input_buffer, start, length, &number, &length))
+    {
+        return false; /* parse_error */
+    }
+
+    item->valuedouble = number;
+
+    /* use saturation in case of overflow */
+    if (number >= INT_MAX)
+    {
+        item->valueint = INT_MAX;
+    }
+    else if (number <= (double)INT_MIN)
+    {
+        item->valueint = INT_MIN;
+    }
+    else
+    {
+        item->valueint = (int)number;
+    }
+
+    item->type = cJSON_Number;
+
+    input_buffer->offset += length;
+    return true;
+}
+
+/* don't ask me, but the original cJSON_SetNumberValue returns an integer or double */
+CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number)
+{
+    if (number >= INT_MAX)
+    {
+        object->valueint = INT_MAX;
+    }
+    else if (number <= (double)INT_MIN)
+    {
+        object->valueint = INT_MIN;
+    }
+    else
+    {
+        object->valueint = (int)number;
+    }
+
+    return object->valuedouble = number;
+}
+
+CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
+{
+    char *copy = NULL;
+    /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring */
+    if (!(object->type & cJSON_String) || (object->type & cJSON_IsReference))
+    {
+        return NULL;
+    }
+    if (strlen(valuestring) <= strlen(object->valuestring))
+    {
+        strcpy(object->valuestring, valuestring);
+        return object->valuestring;
+    }
+    copy = (char*) cJSON_strdup((const unsigned char*)valuestring, &global_hooks);
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+    if (object->valuestring != NULL)
+    {
+        cJSON_free(object->valuestring);
+    }
+    object->valuestring = copy;
+
+    return copy;
+}
+
+typedef struct
+{
+    unsigned char *buffer;
+    size_t length;
+    size_t offset;
+    size_t depth; /* current nesting depth (for formatted printing) */
+    cJSON_bool noalloc;
+    cJSON_bool format; /* is this print a formatted print */
+    internal_hooks hooks;
+} printbuffer;
+
+/* realloc printbuffer if necessary to have at least "needed" bytes more */
+static unsigned char* ensure(printbuffer * const p, size_t needed)
+{
+    unsigned char *newbuffer = NULL;
+    size_t newsize = 0;
+
+    if ((p == NULL) || (p->buffer == NULL))
+    {
+        return NULL;
+    }
+
+    if ((p->length > 0) && (p->offset >= p->length))
+    {
+        /* make sure that offset is valid */
+        return NULL;
+    }
+
+    if (needed > INT_MAX)
+    {
+        /* sizes bigger than INT_MAX are currently not supported */
+        return NULL;
+    }
+
+    needed += p->offset + 1;
+    if (needed <= p->length)
+    {
+        return p->buffer + p->offset;
+    }
+
+    if (p->noalloc) {
+        return NULL;
+    }
+
+    /* calculate new buffer size */
+    if (needed > (INT_MAX / 2))
+    {
+        /* overflow of int, use INT_MAX if possible */
+        if (needed <= INT_MAX)
+        {
+            newsize = INT_MAX;
+        }
+        else
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        newsize = needed * 2;
+    }
+
+    if (p->hooks.reallocate != NULL)
+    {
+        /* reallocate with realloc if available */
+        newbuffer = (unsigned char*)p->hooks.reallocate(p->buffer, newsize);
+        if (newbuffer == NULL)
+        {
+            p->hooks.deallocate(p->buffer);
+            p->length = 0;
+            p->buffer = NULL;
+
+            return NULL;
+        }
+    }
+    else
+    {
+        /* otherwise reallocate manually */
+        newbuffer = (unsigned char*)p->hooks.allocate(newsize);
+        if (!newbuffer)
+        {
+            p->hooks.deallocate(p->buffer);
+            p->length = 0;
+            p->buffer = NULL;
+
+            return NULL;
+        }
+        
+        memcpy(newbuffer, p->buffer, p->offset + 1);
+        p->hooks.deallocate(p->buffer);
+    }
+    p->length = newsize;
+    p->buffer = newbuffer;
+
+    return newbuffer + p->offset;
+}
+
+/* calculate the new length of the string in a printbuffer and update the offset */
+static void update_offset(printbuffer * const buffer)
+{
+    const unsigned char *buffer_pointer = NULL;
+    if ((buffer == NULL) || (buffer->buffer == NULL))
+    {
+        return;
+    }
+    buffer_pointer = buffer->buffer + buffer->offset;
+
+    buffer->offset += strlen((const char*)buffer_pointer);
+}
+
+/* securely comparison of floating-point variables */
+static cJSON_bool compare_double(double a, double b)
+{
+    double maxVal = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
+    return (fabs(a - b) <= maxVal * DBL_EPSILON);
+}
+
+#ifdef CJSON_64BIT_DOUBLES
+/* Grisu2 (Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers") as in RapidJSON:
+ * prints the shortest digits that read back to the same double in nearly all cases and
+ * digits that still read back exactly in the rest, using only 64 bit integer arithmetic. */
+typedef struct
+{
+    unsigned long f; /* significand */
+    int e; /* binary exponent */
+} diy_fp;
+
+#define DOUBLE_HIDDEN_BIT 0x0010000000000000UL
+#define DOUBLE_SIGNIFICAND_MASK 0x000FFFFFFFFFFFFFUL
+
+/* normalized 10^(-348 + 8 * index) rounded to 64 bits */
+static const diy_fp grisu_cached_powers[] =
+{
+    { 0xFA8FD5A0081C0288UL, -1220 },
+    { 0xBAAEE17FA23EBF76UL, -1193 },
+    { 0x8B16FB203055AC76UL, -1166 },
+    { 0xCF42894A5DCE35EAUL, -1140 },
+    { 0x9A6BB0AA55653B2DUL, -1113 },
+    { 0xE61ACF033D1A45DFUL, -1087 },
+    { 0xAB70FE17C79AC6CAUL, -1060 },
+    { 0xFF77B1FCBEBCDC4FUL, -1034 },
+    { 0xBE5691EF416BD60CUL, -1007 },
+    { 0x8DD01FAD907FFC3CUL, -980 },
+    { 0xD3515C2831559A83UL, -954 },
+    { 0x9D71AC8FADA6C9B5UL, -927 },
+    { 0xEA9C227723EE8BCBUL, -901 },
+    { 0xAECC49914078536DUL, -874 },
+    { 0x823C12795DB6CE57UL, -847 },
+    { 0xC21094364DFB5637UL, -821 },
+    { 0x9096EA6F3848984FUL, -794 },
+    { 0xD77485CB25823AC7UL, -768 },
+    { 0xA086CFCD97BF97F4UL, -741 },
+    { 0xEF340A98172AACE5UL, -715 },
+    { 0xB23867FB2A35B28EUL, -688 },
+    { 0x84C8D4DFD2C63F3BUL, -661 },
+    { 0xC5DD44271AD3CDBAUL, -635 },
+    { 0x936B9FCEBB25C996UL, -608 },
+    { 0xDBAC6C247D62A584UL, -582 },
+    { 0xA3AB66580D5FDAF6UL, -555 },
+    { 0xF3E2F893DEC3F126UL, -529 },
+    { 0xB5B5ADA8AAFF80B8UL, -502 },
+    { 0x87625F056C7C4A8BUL, -475 },
+    { 0xC9BCFF6034C13053UL, -449 },
+    { 0x964E858C91BA2655UL, -422 },
+    { 0xDFF9772470297EBDUL, -396 },
+    { 0xA6DFBD9FB8E5B88FUL, -369 },
+    { 0xF8A95FCF88747D94UL, -343 },
+    { 0xB94470938FA89BCFUL, -316 },
+    { 0x8A08F0F8BF0F156BUL, -289 },
+    { 0xCDB02555653131B6UL, -263 },
+    { 0x993FE2C6D07B7FACUL, -236 },
+    { 0xE45C10C42A2B3B06UL, -210 },
+    { 0xAA242499697392D3UL, -183 },
+    { 0xFD87B5F28300CA0EUL, -157 },
+    { 0xBCE5086492111AEBUL, -130 },
+    { 0x8CBCCC096F5088CCUL, -103 },
+    { 0xD1B71758E219652CUL, -77 },
+    { 0x9C40000000000000UL, -50 },
+    { 0xE8D4A51000000000UL, -24 },
+    { 0xAD78EBC5AC620000UL, 3 },
+    { 0x813F3978F8940984UL, 30 },
+    { 0xC097CE7BC90715B3UL, 56 },
+    { 0x8F7E32CE7BEA5C70UL, 83 },
+    { 0xD5D238A4ABE98068UL, 109 },
+    { 0x9F4F2726179A2245UL, 136 },
+    { 0xED63A231D4C4FB27UL, 162 },
+    { 0xB0DE65388CC8ADA8UL, 189 },
+    { 0x83C7088E1AAB65DBUL, 216 },
+    { 0xC45D1DF942711D9AUL, 242 },
+    { 0x924D692CA61BE758UL, 269 },
+    { 0xDA01EE641A708DEAUL, 295 },
+    { 0xA26DA3999AEF774AUL, 322 },
+    { 0xF209787BB47D6B85UL, 348 },
+    { 0xB454E4A179DD1877UL, 375 },
+    { 0x865B86925B9BC5C2UL, 402 },
+    { 0xC83553C5C8965D3DUL, 428 },
+    { 0x952AB45CFA97A0B3UL, 455 },
+    { 0xDE469FBD99A05FE3UL, 481 },
+    { 0xA59BC234DB398C25UL, 508 },
+    { 0xF6C69A72A3989F5CUL, 534 },
+    { 0xB7DCBF5354E9BECEUL, 561 },
+    { 0x88FCF317F22241E2UL, 588 },
+    { 0xCC20CE9BD35C78A5UL, 614 },
+    { 0x98165AF37B2153DFUL, 641 },
+    { 0xE2A0B5DC971F303AUL, 667 },
+    { 0xA8D9D1535CE3B396UL, 694 },
+    { 0xFB9B7CD9A4A7443CUL, 720 },
+    { 0xBB764C4CA7A44410UL, 747 },
+    { 0x8BAB8EEFB6409C1AUL, 774 },
+    { 0xD01FEF10A657842CUL, 800 },
+    { 0x9B10A4E5E9913129UL, 827 },
+    { 0xE7109BFBA19C0C9DUL, 853 },
+    { 0xAC2820D9623BF429UL, 880 },
+    { 0x80444B5E7AA7CF85UL, 907 },
+    { 0xBF21E44003ACDD2DUL, 933 },
+    { 0x8E679C2F5E44FF8FUL, 960 },
+    { 0xD433179D9C8CB841UL, 986 },
+    { 0x9E19DB92B4E31BA9UL, 1013 },
+    { 0xEB96BF6EBADF77D9UL, 1039 },
+    { 0xAF87023B9BF0EE6BUL, 1066 }
+};
+
+static const unsigned long grisu_powers_of_ten[] =
+{
+    1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL,
+    10000000000UL, 100000000000UL, 1000000000000UL, 10000000000000UL, 100000000000000UL,
+    1000000000000000UL, 10000000000000000UL, 100000000000000000UL, 1000000000000000000UL,
+    10000000000000000000UL
+};
+
+/* product of two diy_fp, rounded to 64 bits */
+static diy_fp diy_fp_multiply(const diy_fp x, const diy_fp y)
+{
+    diy_fp product;
+    unsigned long low = 0;
+
+    multiply_wide(x.f, y.f, &product.f, &low);
+    product.f += low >> 63;
+    product.e = x.e + y.e + 64;
+
+    return product;
+}
+
+static diy_fp diy_fp_normalize(diy_fp x, const unsigned long top_bit)
+{
+    while (!(x.f & top_bit))
+    {
+        x.f <<= 1;
+        x.e--;
+    }
+
+    return x;
+}
+
+/* move the last digit towards the exact value as long as it stays inside the rounding interval */
+static void grisu_round(unsigned char * const buffer, const int length, const unsigned long delta, unsigned long rest, const unsigned long ten_kappa, const unsigned long wp_w)
+{
+    while ((rest < wp_w) && ((delta - rest) >= ten_kappa)
+           && (((rest + ten_kappa) < wp_w) || ((wp_w - rest) > (rest + ten_kappa - wp_w))))
+    {
+        buffer[length - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+/* generate the digits of w until they identify a number inside (mp - delta, mp) */
+static void grisu_digits(const diy_fp w, const diy_fp mp, unsigned long delta, unsigned char * const buffer, int * const length, int * const exponent)
+{
+    const int shift = -mp.e;
+    const unsigned long one = 1UL << shift;
+    const unsigned long wp_w = mp.f - w.f;
+    unsigned long p1 = mp.f >> shift; /* integer part, fits into 32 bits */
+    unsigned long p2 = mp.f & (one - 1);
+    int kappa = 1;
+
+    while ((kappa < 10) && (p1 >= grisu_powers_of_ten[kappa]))
+    {
+        kappa++;
+    }
+
+    *length = 0;
+    while (kappa > 0)
+    {
+        unsigned long digit = p1 / grisu_powers_of_ten[kappa - 1];
+        unsigned long rest = 0;
+        p1 %= grisu_powers_of_ten[kappa - 1];
+        if ((digit != 0) || (*length != 0))
+        {
+            buffer[(*length)++] = (unsigned char)('0' + digit);
+        }
+        kappa--;
+        rest = (p1 << shift) + p2;
+        if (rest <= delta)
+        {
+            *exponent += kappa;
+            grisu_round(buffer, *length, delta, rest, grisu_powers_of_ten[kappa] << shift, wp_w);
+            return;
+        }
+    }
+
+    for (;;)
+    {
+        unsigned long digit = 0;
+        p2 *= 10;
+        delta *= 10;
+        digit = p2 >> shift;
+        if ((digit != 0) || (*length != 0))
+        {
+            buffer[(*length)++] = (unsigned char)('0' + digit);
+        }
+        p2 &= one - 1;
+        kappa--;
+        if (p2 < delta)
+        {
+            *exponent += kappa;
+            grisu_round(buffer, *length, delta, p2, one, (-kappa < 20) ? (wp_w * grisu_powers_of_ten[-kappa]) : 0);
+            return;
+        }
+    }
+}
+
+/* digits of a positive finite double, the value is digits * 10^exponent */
+static void grisu2(const double value, unsigned char * const buffer, int * const length, int * const exponent)
+{
+    unsigned long bits = 0;
+    diy_fp v;
+    diy_fp plus;
+    diy_fp minus;
+    diy_fp cached;
+    diy_fp w;
+    int biased_exponent = 0;
+    int k = 0;
+    int index = 0;
+    double dk = 0;
+
+    memcpy(&bits, &value, sizeof(bits));
+    biased_exponent = (int)((bits >> 52) & 0x7FF);
+    v.f = bits & DOUBLE_SIGNIFICAND_MASK;
+    if (biased_exponent != 0)
+    {
+        v.f += DOUBLE_HIDDEN_BIT;
+        v.e = biased_exponent - 1075;
+    }
+    else
+    {
+        v.e = -1074;
+    }
+
+    /* boundaries halfway to the neighbouring doubles, with the exponent of the normalized upper one */
+    plus.f = (v.f << 1) + 1;
+    plus.e = v.e - 1;
+    plus = diy_fp_normalize(plus, DOUBLE_HIDDEN_BIT << 1);
+    plus.f <<= 10;
+    plus.e -= 10;
+    if (v.f == DOUBLE_HIDDEN_BIT)
+    {
+        minus.f = (v.f << 2) - 1;
+        minus.e = v.e - 2;
+    }
+    else
+    {
+        minus.f = (v.f << 1) - 1;
+        minus.e = v.e - 1;
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    /* cached power of ten that brings the upper boundary's exponent into [-60, -32] */
+    dk = ((-61 - plus.e) * 0.30102999566398114) + 347;
+    k = (int)dk;
+    if ((dk - k) > 0.0)
+    {
+        k++;
+    }
+    index = (k >> 3) + 1;
+    cached = grisu_cached_powers[index];
+    *exponent = 348 - (index * 8);
+
+    w = diy_fp_multiply(diy_fp_normalize(v, 0x8000000000000000UL), cached);
+    plus = diy_fp_multiply(plus, cached);
+    minus = diy_fp_multiply(minus, cached);
+    minus.f++;
+    plus.f--;
+
+    grisu_digits(w, plus, plus.f - minus.f, buffer, length, exponent);
+}
+
+/* whether mantissa * 10^exponent reads back as exactly d */
+static cJSON_bool digits_read_back(const double d, const unsigned long mantissa, const int exponent)
+{
+    double candidate = 0;
+
+    if (!decimal_to_double(mantissa, exponent, &candidate))
+    {
+        /* no decimal point, so the locale does not matter */
+        char candidate_string[32];
+        sprintf(candidate_string, "%lue%d", mantissa, exponent);
+        candidate = strtod(candidate_string, NULL);
+    }
+
+    return memcmp(&candidate, &d, sizeof(d)) == 0;
+}
+
+/* Round the digits to count significant digits and check that they read back as d. The digits of Grisu2 are
+ * not the exact expansion of d, so when the dropped digits are exactly one half the other neighbour is tried too. */
+static cJSON_bool round_digits(const double d, const unsigned char * const digits, const int digit_count, const int exponent, const int count, unsigned long * const mantissa)
+{
+    cJSON_bool half = (digits[count] == '5');
+    int i = 0;
+
+    *mantissa = 0;
+    for (i = 0; i < count; i++)
+    {
+        *mantissa = (*mantissa * 10) + (unsigned long)(digits[i] - '0');
+    }
+    for (i = count + 1; i < digit_count; i++)
+    {
+        half = half && (digits[i] == '0');
+    }
+    if (digits[count] >= '5')
+    {
+        (*mantissa)++;
+    }
+
+    if (digits_read_back(d, *mantissa, exponent + (digit_count - count)))
+    {
+        return true;
+    }
+    if (half && digits_read_back(d, *mantissa - 1, exponent + (digit_count - count)))
+    {
+        (*mantissa)--;
+        return true;
+    }
+
+    return false;
+}
+
+/* Grisu2 occasionally returns more digits than needed, see whether 16 and then 15 significant digits
+ * read back as the same double */
+static void shorten_digits(const double d, unsigned char * const digits, int * const digit_count, int * const exponent)
+{
+    unsigned long mantissa = 0;
+    unsigned long candidate = 0;
+    int shortest = 0;
+    int count = 0;
+    int i = 0;
+
+    for (count = *digit_count - 1; (count >= 15) && round_digits(d, digits, *digit_count, *exponent, count, &candidate); count--)
+    {
+        shortest = count;
+        mantissa = candidate;
+    }
+    if (shortest == 0)
+    {
+        return;
+    }
+
+    *exponent += *digit_count - shortest;
+    *digit_count = shortest;
+    for (i = shortest - 1; i >= 0; i--)
+    {
+        digits[i] = (unsigned char)('0' + (mantissa % 10));
+        mantissa /= 10;
+    }
+    if (mantissa != 0)
+    {
+        /* rounded up to the next power of ten */
+        digits[0] = '1';
+        *digit_count = 1;
+        *exponent += shortest;
+    }
+}
+
+/* print a finite double like "%1.15g", or "%1.17g" when more than 15 digits are needed, but with the shortest digits */
+static int print_shortest(double d, unsigned char * const output)
+{
+    unsigned char digits[20];
+    int digit_count = 0;
+    int exponent = 0;
+    int scientific_exponent = 0;
+    int precision = 0;
+    int length = 0;
+    int i = 0;
+    unsigned long bits = 0;
+
+    memcpy(&bits, &d, sizeof(bits));
+    if (bits >> 63)
+    {
+        output[length++] = '-';
+        d = -d;
+    }
+
+    if (d == 0)
+    {
+        output[length++] = '0';
+        return length;
+    }
+
+    /* integers are printed as they are */
+    if ((d < 1e15) && (d == floor(d)))
+    {
+        unsigned long integer = (unsigned long)d;
+        for (; integer != 0; integer /= 10)
+        {
+            digits[digit_count++] = (unsigned char)('0' + (integer % 10));
+        }
+        while (digit_count > 0)
+        {
+            output[length++] = digits[--digit_count];
+        }
+        return length;
+    }
+
+    grisu2(d, digits, &digit_count, &exponent);
+    shorten_digits(d, digits, &digit_count, &exponent);
+    while ((digit_count > 1) && (digits[digit_count - 1] == '0'))
+    {
+        digit_count--;
+        exponent++;
+    }
+
+    scientific_exponent = digit_count + exponent - 1;
+    precision = (digit_count <= 15) ? 15 : 17;
+    if ((scientific_exponent < -4) || (scientific_exponent >= precision))
+    {
+        /* d.ddde+XX */
+        output[length++] = digits[0];
+        if (digit_count > 1)
+        {
+            output[length++] = '.';
+            memcpy(output + length, digits + 1, (size_t)(digit_count - 1));
+            length += digit_count - 1;
+        }
+        output[length++] = 'e';
+        output[length++] = (scientific_exponent < 0) ? '-' : '+';
+        if (scientific_exponent < 0)
+        {
+            scientific_exponent = -scientific_exponent;
+        }
+        if (scientific_exponent >= 100)
+        {
+            output[length++] = (unsigned char)('0' + (scientific_exponent / 100));
+        }
+        output[length++] = (unsigned char)('0' + ((scientific_exponent / 10) % 10));
+        output[length++] = (unsigned char)('0' + (scientific_exponent % 10));
+    }
+    else if (scientific_exponent < 0)
+    {
+        /* 0.000ddd */
+        output[length++] = '0';
+        output[length++] = '.';
+        for (i = -1; i > scientific_exponent; i--)
+        {
+            output[length++] = '0';
+        }
+        memcpy(output + length, digits, (size_t)digit_count);
+        length += digit_count;
+    }
+    else
+    {
+        /* ddd.ddd or ddd000 */
+        for (i = 0; (i < digit_count) || (i <= scientific_exponent); i++)
+        {
+            if (i == (scientific_exponent + 1))
+            {
+                output[length++] = '.';
+            }
+            output[length++] = (i < digit_count) ? digits[i] : (unsigned char)'0';
+        }
+    }
+
+    return length;
+}
+#endif
+
+/* Render the number nicely from the given item into a string. */
+static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    double d = item->valuedouble;
+    int length = 0;
+    size_t i = 0;
+    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
+    unsigned char decimal_point = '.';
+#ifndef CJSON_64BIT_DOUBLES
+    double test = 0.0;
+#endif
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* This checks for NaN and Infinity */
+    if (isnan(d) || isinf(d))
+    {
+        length = sprintf((char*)number_buffer, "null");
+    }
+    else
+    {
+#ifdef CJSON_64BIT_DOUBLES
+        length = print_shortest(d, number_buffer);
+#else
+        decimal_point = get_decimal_point();
+
+        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
+        length = sprintf((char*)number_buffer, "%1.15g", d);
+
+        /* Check whether the original double can be recovered */
+        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
+        {
+            /* If not, print with 17 decimal places of precision */
+            length = sprintf((char*)number_buffer, "%1.17g", d);
+        }
+#endif
+    }
+
+    /* sprintf failed or buffer overrun occurred */
+    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
+    {
+        return false;
+    }
+
+    /* reserve appropriate space in the output */
+    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    /* copy the printed number to the output and replace locale
+     * dependent decimal point with '.' */
+    for (i = 0; i < ((size_t)length); i++)
+    {
+        if (number_buffer[i] == decimal_point)
+        {
+            output_pointer[i] = '.';
+            continue;
+        }
+
+        output_pointer[i] = number_buffer[i];
+    }
+    output_pointer[i] = '\0';
+
+    output_buffer->offset += (size_t)length;
+
+    return true;
+}
+
+/* parse 4 digit hexadecimal number */
+static unsigned parse_hex4(const unsigned char * const input)
+{
+    unsigned int h = 0;
+    size_t i = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        /* parse digit */
+        if ((input[i] >= '0') && (input[i] <= '9'))
+        {
+            h += (unsigned int) input[i] - '0';
+        }
+        else if ((input[i] >= 'A') && (input[i] <= 'F'))
+        {
+            h += (unsigned int) 10 + input[i] - 'A';
+        }
+        else if ((input[i] >= 'a') && (input[i] <= 'f'))
+        {
+            h += (unsigned int) 10 + input[i] - 'a';
+        }
+        else /* invalid */
+        {
+            return 0;
+        }
+
+        if (i < 3)
+        {
+            /* shift left to make place for the next nibble */
+            h = h << 4;
+        }
+    }
+
+    return h;
+}
+
+/* converts a UTF-16 literal to UTF-8
+ * A literal can be one or two sequences of the form \uXXXX */
+static unsigned char utf16_literal_to_utf8(const unsigned char * const input_pointer, const unsigned char * const input_end, unsigned char **output_pointer)
+{
+    long unsigned int codepoint = 0;
+    unsigned int first_code = 0;
+    const unsigned char *first_sequence = input_pointer;
+    unsigned char utf8_length = 0;
+    unsigned char utf8_position = 0;
+    unsigned char sequence_length = 0;
+    unsigned char first_byte_mark = 0;
+
+    if ((input_end - first_sequence) < 6)
+    {
+        /* input ends unexpectedly */
+        goto fail;
+    }
+
+    /* get the first utf16 sequence */
+    first_code = parse_hex4(first_sequence + 2);
+
+    /* check that the code is valid */
+    if (((first_code >= 0xDC00) && (first_code <= 0xDFFF)))
+    {
+        goto fail;
+    }
+
+    /* UTF16 surrogate pair */
+    if ((first_code >= 0xD800) && (first_code <= 0xDBFF))
+    {
+        const unsigned char *second_sequence = first_sequence + 6;
+        unsigned int second_code = 0;
+        sequence_length = 12; /* \uXXXX\uXXXX */
+
+        if ((input_end - second_sequence) < 6)
+        {
+            /* input ends unexpectedly */
+            goto fail;
+        }
+
+        if ((second_sequence[0] != '\\') || (second_sequence[1] != 'u'))
+        {
+            /* missing second half of the surrogate pair */
+            goto fail;
+        }
+
+        /* get the second utf16 sequence */
+        second_code = parse_hex4(second_sequence + 2);
+        /* check that the code is valid */
+        if ((second_code < 0xDC00) || (second_code > 0xDFFF))
+        {
+            /* invalid second half of the surrogate pair */
+            goto fail;
+        }
+
+
+        /* calculate the unicode codepoint from the surrogate pair */
+        codepoint = 0x10000 + (((first_code & 0x3FF) << 10) | (second_code & 0x3FF));
+    }
+    else
+    {
+        sequence_length = 6; /* \uXXXX */
+        codepoint = first_code;
+    }
+
+    /* encode as UTF-8
+     * takes at maximum 4 bytes to encode:
+     * 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
+    if (codepoint < 0x80)
+    {
+        /* normal ascii, encoding 0xxxxxxx */
+        utf8_length = 1;
+    }
+    else if (codepoint < 0x800)
+    {
+        /* two bytes, encoding 110xxxxx 10xxxxxx */
+        utf8_length = 2;
+        first_byte_mark = 0xC0; /* 11000000 */
+    }
+    else if (codepoint < 0x10000)
+    {
+        /* three bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx */
+        utf8_length = 3;
+        first_byte_mark = 0xE0; /* 11100000 */
+    }
+    else if (codepoint <= 0x10FFFF)
+    {
+        /* four bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx 10xxxxxx */
+        utf8_length = 4;
+        first_byte_mark = 0xF0; /* 11110000 */
+    }
+    else
+    {
+        /* invalid unicode codepoint */
+        goto fail;
+    }
+
+    /* encode as utf8 */
+    for (utf8_position = (unsigned char)(utf8_length - 1); utf8_position > 0; utf8_position--)
+    {
+        /* 10xxxxxx */
+        (*output_pointer)[utf8_position] = (unsigned char)((codepoint | 0x80) & 0xBF);
+        codepoint >>= 6;
+    }
+    /* encode first byte */
+    if (utf8_length > 1)
+    {
+        (*output_pointer)[0] = (unsigned char)((codepoint | first_byte_mark) & 0xFF);
+    }
+    else
+    {
+        (*output_pointer)[0] = (unsigned char)(codepoint & 0x7F);
+    }
+
+    *output_pointer += utf8_length;
+
+    return sequence_length;
+
+fail:
+    return 0;
+}
+
+#ifdef CJSON_SSE2
+/* index of the lowest set bit, mask must not be 0 */
+static size_t first_set_bit(unsigned int mask)
+{
+#if defined(__GNUC__)
+    return (size_t)__builtin_ctz(mask);
+#else
+    size_t index = 0;
+    while (!(mask & 1U))
+    {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+#endif
+
+/* find the first '\"' or '\\' in [pointer, end), returns end if there is none.
+ * With SSE2 16 bytes are compared at once, the scalar loop handles the tail and other targets. */
+static const unsigned char *find_quote_or_backslash(const unsigned char *pointer, const unsigned char * const end)
+{
+#ifdef CJSON_SSE2
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    while ((size_t)(end - pointer) >= 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)pointer);
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)));
+        if (mask != 0)
+        {
+            return pointer + first_set_bit((unsigned int)mask);
+        }
+        pointer += 16;
+    }
+#endif
+    while ((pointer < end) && (*pointer != '\"') && (*pointer != '\\'))
+    {
+        pointer++;
+    }
+
+    return pointer;
+}
+
+/* Parse the input text into an unescaped cinput, and populate item. */
+static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
+{
+    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
+    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
+    unsigned char *output_pointer = NULL;
+    unsigned char *output = NULL;
+
+    /* not a string */
+    if (buffer_at_offset(input_buffer)[0] != '\"')
+    {
+        goto fail;
+    }
+
+    {
+        /* calculate approximate size of the output (overestimate) */
+        size_t allocation_length = 0;
+        size_t skipped_bytes = 0;
+        const unsigned char *buffer_end = input_buffer->content + input_buffer->length;
+        for (;;)
+        {
+            /* jump over the plain characters to the next quote or escape sequence */
+            input_end = find_quote_or_backslash(input_end, buffer_end);
+            if ((input_end >= buffer_end) || (*input_end == '\"'))
+            {
+                break;
+            }
+            if ((input_end + 1) >= buffer_end)
+            {
+                /* prevent buffer overflow when last input character is a backslash */
+                goto fail;
+            }
+            skipped_bytes++;
+            input_end += 2;
+        }
+        if ((input_end >= buffer_end) || (*input_end != '\"'))
+        {
+            goto fail; /* string ended unexpectedly */
+        }
+
+        /* This is at most how much we need for the output */
+        allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
+        output = (unsigned char*)parse_allocate(input_buffer, allocation_length + sizeof(""));
+        if (output == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+    }
+
+    output_pointer = output;
+    /* loop through the string literal */
+    while (input_pointer < input_end)
+    {
+        if (*input_pointer != '\\')
+        {
+            /* copy the run up to the next escape sequence at once, the current character always belongs to it
+             * (a quote can only show up here after a malformed \u escape, it is copied like any other character) */
+            const unsigned char *run_end = find_quote_or_backslash(input_pointer + 1, input_end);
+            size_t run_length = (size_t)(run_end - input_pointer);
+            memcpy(output_pointer, input_pointer, run_length);
+            output_pointer += run_length;
+            input_pointer = run_end;
+        }
+        /* escape sequence */
+        else
+        {
+            unsigned char sequence_length = 2;
+            if ((input_end - input_pointer) < 1)
+            {
+                goto fail;
+            }
+
+            switch (input_pointer[1])
+            {
+                case 'b':
+                    *output_pointer++ = '\b';
+                    break;
+                case 'f':
+                    *output_pointer++ = '\f';
+                    break;
+                case 'n':
+                    *output_pointer++ = '\n';
+                    break;
+                case 'r':
+                    *output_pointer++ = '\r';
+                    break;
+                case 't':
+                    *output_pointer++ = '\t';
+                    break;
+                case '\"':
+                case '\\':
+                case '/':
+                    *output_pointer++ = input_pointer[1];
+                    break;
+
+                /* UTF-16 literal */
+                case 'u':
+                    sequence_length = utf16_literal_to_utf8(input_pointer, input_end, &output_pointer);
+                    if (sequence_length == 0)
+                    {
+                        /* failed to convert UTF16-literal to UTF-8 */
+                        goto fail;
+                    }
+                    break;
+
+                default:
+                    goto fail;
+            }
+            input_pointer += sequence_length;
+        }
+    }
+
+    /* zero terminate the output */
+    *output_pointer = '\0';
+
+    item->type = cJSON_String;
+    item->valuestring = (char*)output;
+
+    input_buffer->offset = (size_t) (input_end - input_buffer->content);
+    input_buffer->offset++;
+
+    return true;
+
+fail:
+    if (output != NULL)
+    {
+        parse_deallocate(input_buffer, output);
+    }
+
+    if (input_pointer != NULL)
+    {
+        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+    }
+
+    return false;
+}
+
+/* Render the cstring provided to an escaped version that can be printed. */
+static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffer * const output_buffer)
+{
+    const unsigned char *input_pointer = NULL;
+    unsigned char *output = NULL;
+    unsigned char *output_pointer = NULL;
+    size_t output_length = 0;
+    /* numbers of additional characters needed for escaping */
+    size_t escape_characters = 0;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* empty string */
+    if (input == NULL)
+    {
+        output = ensure(output_buffer, sizeof("\"\""));
+        if (output == NULL)
+        {
+            return false;
+        }
+        strcpy((char*)output, "\"\"");
+
+        return true;
+    }
+
+    /* set "flag" to 1 if something needs to be escaped */
+    for (input_pointer = input; *input_pointer; input_pointer++)
+    {
+        switch (*input_pointer)
+        {
+            case '\"':
+            case '\\':
+            case '\b':
+            case '\f':
+            case '\n':
+            case '\r':
+            case '\t':
+                /* one character escape sequence */
+                escape_characters++;
+                break;
+            default:
+                if (*input_pointer < 32)
+                {
+                    /* UTF-16 escape sequence uXXXX */
+                    escape_characters += 5;
+                }
+                break;
+        }
+    }
+    output_length = (size_t)(input_pointer - input) + escape_characters;
+
+    output = ensure(output_buffer, output_length + sizeof("\"\""));
+    if (output == NULL)
+    {
+        return false;
+    }
+
+    /* no characters have to be escaped */
+    if (escape_characters == 0)
+    {
+        output[0] = '\"';
+        memcpy(output + 1, input, output_length);
+        output[output_length + 1] = '\"';
+        output[output_length + 2] = '\0';
+
+        return true;
+    }
+
+    output[0] = '\"';
+    output_pointer = output + 1;
+    /* copy the string */
+    for (input_pointer = input; *input_pointer != '\0'; (void)input_pointer++, output_pointer++)
+    {
+        if ((*input_pointer > 31) && (*input_pointer != '\"') && (*input_pointer != '\\'))
+        {
+            /* normal character, copy */
+            *output_pointer = *input_pointer;
+        }
+        else
+        {
+            /* character needs to be escaped */
+            *output_pointer++ = '\\';
+            switch (*input_pointer)
+            {
+                case '\\':
+                    *output_pointer = '\\';
+                    break;
+                case '\"':
+                    *output_pointer = '\"';
+                    break;
+                case '\b':
+                    *output_pointer = 'b';
+                    break;
+                case '\f':
+                    *output_pointer = 'f';
+                    break;
+                case '\n':
+                    *output_pointer = 'n';
+                    break;
+                case '\r':
+                    *output_pointer = 'r';
+                    break;
+                case '\t':
+                    *output_pointer = 't';
+                    break;
+                default:
+                    /* escape and print as unicode codepoint */
+                    sprintf((char*)output_pointer, "u%04x", *input_pointer);
+                    output_pointer += 4;
+                    break;
+            }
+        }
+    }
+    output[output_length + 1] = '\"';
+    output[output_length + 2] = '\0';
+
+    return true;
+}
+
+/* Invoke print_string_ptr (which is useful) on an item. */
+static cJSON_bool print_string(const cJSON * const item, printbuffer * const p)
+{
+    return print_string_ptr((unsigned char*)item->valuestring, p);
+}
+
+/* Predeclare these prototypes. */
+static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer);
+
+/* Utility to jump whitespace and cr/lf */
+static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL))
+    {
+        return NULL;
+    }
+
+    if (cannot_access_at_index(buffer, 0))
+    {
+        return buffer;
+    }
+
+    while (can_access_at_index(buffer, 0) && (buffer_at_offset(buffer)[0] <= 32))
+    {
+       buffer->offset++;
+    }
+
+    if (buffer->offset == buffer->length)
+    {
+        buffer->offset--;
+    }
+
+    return buffer;
+}
+
+/* skip the UTF-8 BOM (byte order mark) if it is at the beginning of a buffer */
+static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL) || (buffer->offset != 0))
+    {
+        return NULL;
+    }
+
+    if (can_access_at_index(buffer, 4) && (strncmp((const char*)buffer_at_offset(buffer), "\xEF\xBB\xBF", 3) == 0))
+    {
+        buffer->offset += 3;
+    }
+
+    return buffer;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    size_t buffer_length;
+
+    if (NULL == value)
+    {
+        return NULL;
+    }
+
+    /* Adding null character size due to require_null_terminated. */
+    buffer_length = strlen(value) + sizeof("");
+
+    return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
+}
+
+/* Parse an object - create a new root, and populate. The error position goes to error_state. */
+static cJSON *parse_root(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated, cJSON_Arena *arena, const cJSON_Context *context, error * const error_state)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, NULL, NULL };
+    cJSON *item = NULL;
+
+    /* reset error position */
+    error_state->json = NULL;
+    error_state->position = 0;
+
+    if (value == NULL || 0 == buffer_length)
+    {
+        goto fail;
+    }
+
+    buffer.content = (const unsigned char*)value;
+    buffer.length = buffer_length; 
+    buffer.offset = 0;
+    buffer.hooks = global_hooks;
+    buffer.arena = arena;
+    buffer.context = context;
+
+    item = parse_new_item(&buffer);
+    if (item == NULL) /* memory fail */
+    {
+        goto fail;
+    }
+
+    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
+    {
+        /* parse failure. ep is set. */
+        goto fail;
+    }
+
+    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
+    if (require_null_terminated)
+    {
+        buffer_skip_whitespace(&buffer);
+        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
+        {
+            goto fail;
+        }
+    }
+    if (return_parse_end)
+    {
+        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+    }
+
+    return item;
+
+fail:
+    if (item != NULL)
+    {
+        parse_delete(&buffer, item);
+    }
+
+    if (value != NULL)
+    {
+        error local_error;
+        local_error.json = (const unsigned char*)value;
+        local_error.position = 0;
+
+        if (buffer.offset < buffer.length)
+        {
+            local_error.position = buffer.offset;
+        }
+        else if (buffer.length > 0)
+        {
+            local_error.position = buffer.length - 1;
+        }
+
+        if (return_parse_end != NULL)
+        {
+            *return_parse_end = (const char*)local_error.json + local_error.position;
+        }
+
+        *error_state = local_error;
+    }
+
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    return parse_root(value, buffer_length, return_parse_end, require_null_terminated, NULL, NULL, &global_error);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthArena(const char *value, size_t buffer_length, cJSON_Arena *arena)
+{
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+
+    return parse_root(value, buffer_length, NULL, false, arena, NULL, &global_error);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithContext(const char *value, size_t buffer_length, cJSON_Context *context)
+{
+    error local_error = { NULL, 0 };
+    cJSON *item = NULL;
+
+    if (context == NULL)
+    {
+        return NULL;
+    }
+
+    context->parse_end = NULL;
+    item = parse_root(value, buffer_length, &context->parse_end, context->require_null_terminated, context->arena, context, &local_error);
+    context->error = (local_error.json != NULL) ? (const char*)(local_error.json + local_error.position) : NULL;
+
+    return item;
+}
+
+/* Default options for cJSON_Parse */
+CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+{
+    return cJSON_ParseWithOpts(value, 0, 0);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
+{
+    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+}
+
+/* Selective extraction of values by path (cJSON_ExtractPaths) */
+#define PATH_MAX_SEGMENTS 16
+#define PATH_MAX_PATHS 32
+
+typedef enum
+{
+    path_key,
+    path_index,
+    path_any
+} path_segment_type;
+
+typedef struct
+{
+    path_segment_type type;
+    const unsigned char *key;
+    size_t key_length;
+    size_t index;
+} path_segment;
+
+typedef struct
+{
+    path_segment segments[PATH_MAX_SEGMENTS];
+    size_t count;
+} compiled_path;
+
+typedef struct
+{
+    const compiled_path *paths;
+    int path_count;
+    cJSON_PathCallback callback;
+    void *userdata;
+    cJSON_bool stopped;
+} extract_context;
+
+/* split a path like "consolidated_weather[*].min_temp" into key, [n] and [*] segments */
+static cJSON_bool compile_path(const char * const path, compiled_path * const compiled)
+{
+    const unsigned char *pointer = (const unsigned char*)path;
+
+    compiled->count = 0;
+    while (*pointer != '\0')
+    {
+        path_segment *segment = NULL;
+        if (compiled->count == PATH_MAX_SEGMENTS)
+        {
+            return false;
+        }
+        segment = &compiled->segments[compiled->count];
+
+        if (*pointer == '[')
+        {
+            pointer++;
+            if ((pointer[0] == '*') && (pointer[1] == ']'))
+            {
+                segment->type = path_any;
+                pointer += 2;
+            }
+            else
+            {
+                if ((*pointer < '0') || (*pointer > '9'))
+                {
+                    return false;
+                }
+                segment->type = path_index;
+                segment->index = 0;
+                while ((*pointer >= '0') && (*pointer <= '9'))
+                {
+                    segment->index = (segment->index * 10) + (size_t)(*pointer - '0');
+                    pointer++;
+                }
+                if (*pointer != ']')
+                {
+                    return false;
+                }
+                pointer++;
+            }
+        }
+        else
+        {
+            if ((*pointer == '.') && (compiled->count > 0))
+            {
+                pointer++;
+            }
+            segment->type = path_key;
+            segment->key = pointer;
+            while ((*pointer != '\0') && (*pointer != '.') && (*pointer != '['))
+            {
+                pointer++;
+            }
+            segment->key_length = (size_t)(pointer - segment->key);
+            if (segment->key_length == 0)
+            {
+                return false;
+            }
+        }
+
+        compiled->count++;
+    }
+
+    return true;
+}
+
+/* skip a string without keeping it, the buffer has to point at the opening quote */
+static cJSON_bool skip_string(parse_buffer * const input_buffer)
+{
+    const unsigned char *end = input_buffer->content + input_buffer->length;
+    const unsigned char *pointer = find_quote_or_backslash(buffer_at_offset(input_buffer) + 1, end);
+    cJSON item;
+
+    if ((pointer < end) && (*pointer == '\"'))
+    {
+        /* the common case: nothing to decode */
+        input_buffer->offset = (size_t)(pointer + 1 - input_buffer->content);
+        return true;
+    }
+
+    /* escape sequences are checked by decoding the string once into the scratch arena,
+     * an unterminated string fails there with the same error position as in cJSON_Parse */
+    memset(&item, '\0', sizeof(item));
+    if (input_buffer->arena == NULL)
+    {
+        input_buffer->arena = cJSON_CreateArena(0);
+    }
+    if (!parse_string(&item, input_buffer))
+    {
+        return false;
+    }
+    parse_deallocate(input_buffer, item.valuestring);
+    cJSON_ResetArena(input_buffer->arena);
+
+    return true;
+}
 
-    if (output_buffer == NULL)
+static cJSON_bool skip_value(parse_buffer * const input_buffer);
+
+/* skip the members of an array or object with the grammar of parse_array and parse_object */
+static cJSON_bool skip_children(parse_buffer * const input_buffer, const cJSON_bool object)
+{
+    const unsigned char close = object ? '}' : ']';
+
+    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
-        return false;
+        return false; /* to deeply nested */
     }
+    input_buffer->depth++;
 
-    /* This checks for NaN and Infinity */
-    if (isnan(d) || isinf(d))
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == close))
     {
-        length = sprintf((char*)number_buffer, "null");
+        goto success; /* empty array or object */
     }
-    else
+
+    /* step back to character in front of the first element */
+    input_buffer->offset--;
+    do
     {
-        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
-        length = sprintf((char*)number_buffer, "%1.15g", d);
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (object)
+        {
+            if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '\"'))
+            {
+                return false; /* failed to parse name */
+            }
+            if (!skip_string(input_buffer))
+            {
+                return false;
+            }
+            buffer_skip_whitespace(input_buffer);
+            if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
+            {
+                return false; /* invalid object */
+            }
+            input_buffer->offset++;
+            buffer_skip_whitespace(input_buffer);
+        }
 
-        /* Check whether the original double can be recovered */
-        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
+        if (!skip_value(input_buffer))
         {
-            /* If not, print with 17 decimal places of precision */
-            length = sprintf((char*)number_buffer, "%1.17g", d);
+            return false;
         }
+        buffer_skip_whitespace(input_buffer);
     }
+    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
 
-    /* sprintf failed or buffer overrun occurred */
-    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != close))
     {
-        return false;
+        return false; /* expected end of array or object */
     }
 
-    /* reserve appropriate space in the output */
-    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
-    if (output_pointer == NULL)
+success:
+    input_buffer->depth--;
+    input_buffer->offset++;
+
+    return true;
+}
+
+/* skip a value without building it. It is checked like parse_value checks it, only numbers and
+ * strings that need converting or decoding touch the scratch arena. */
+static cJSON_bool skip_value(parse_buffer * const input_buffer)
+{
+    if (cannot_access_at_index(input_buffer, 0))
     {
         return false;
     }
 
-    /* copy the printed number to the output and replace locale
-     * dependent decimal point with '.' */
-    for (i = 0; i < ((size_t)length); i++)
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "null", 4) == 0))
     {
-        if (number_buffer[i] == decimal_point)
-        {
-            output_pointer[i] = '.';
-            continue;
-        }
-
-        output_pointer[i] = number_buffer[i];
+        input_buffer->offset += 4;
+        return true;
+    }
+    if (can_read(input_buffer, 5) && (strncmp((const char*)buffer_at_offset(input_buffer), "false", 5) == 0))
+    {
+        input_buffer->offset += 5;
+        return true;
+    }
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "true", 4) == 0))
+    {
+        input_buffer->offset += 4;
+        return true;
+    }
+    if (buffer_at_offset(input_buffer)[0] == '\"')
+    {
+        return skip_string(input_buffer);
+    }
+    if ((buffer_at_offset(input_buffer)[0] == '-') || ((buffer_at_offset(input_buffer)[0] >= '0') && (buffer_at_offset(input_buffer)[0] <= '9')))
+    {
+        cJSON item;
+        memset(&item, '\0', sizeof(item));
+        return parse_number(&item, input_buffer);
+    }
+    if ((buffer_at_offset(input_buffer)[0] == '[') || (buffer_at_offset(input_buffer)[0] == '{'))
+    {
+        return skip_children(input_buffer, buffer_at_offset(input_buffer)[0] == '{');
     }
-    output_pointer[i] = '\0';
-
-    output_buffer->offset += (size_t)length;
 
-    return true;
+    return false;
 }
 
-/* parse 4 digit hexadecimal number */
-static unsigned parse_hex4(const unsigned char * const input)
+static cJSON_bool extract_value(extract_context * const context, parse_buffer * const input_buffer, const size_t level, const unsigned long active, const int element);
+
+/* walk an object, descending only into members that continue one of the active paths */
+static cJSON_bool extract_object(extract_context * const context, parse_buffer * const input_buffer, const size_t level, const unsigned long active, const int element)
 {
-    unsigned int h = 0;
-    size_t i = 0;
+    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
+    {
+        return false; /* to deeply nested */
+    }
+    input_buffer->depth++;
 
-    for (i = 0; i < 4; i++)
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '}'))
     {
-        /* parse digit */
-        if ((input[i] >= '0') && (input[i] <= '9'))
+        goto success; /* empty object */
+    }
+
+    /* step back to character in front of the first element */
+    input_buffer->offset--;
+    do
+    {
+        const unsigned char *key = NULL;
+        size_t key_length = 0;
+        unsigned long matching = 0;
+        int index = 0;
+
+        /* the name of the child is compared without decoding escape sequences */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '\"'))
         {
-            h += (unsigned int) input[i] - '0';
+            return false; /* failed to parse name */
         }
-        else if ((input[i] >= 'A') && (input[i] <= 'F'))
+        key = buffer_at_offset(input_buffer) + 1;
+        if (!skip_string(input_buffer))
         {
-            h += (unsigned int) 10 + input[i] - 'A';
+            return false;
         }
-        else if ((input[i] >= 'a') && (input[i] <= 'f'))
+        key_length = (size_t)(buffer_at_offset(input_buffer) - key) - 1;
+        buffer_skip_whitespace(input_buffer);
+        if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
         {
-            h += (unsigned int) 10 + input[i] - 'a';
+            return false; /* invalid object */
         }
-        else /* invalid */
+
+        for (index = 0; index < context->path_count; index++)
         {
-            return 0;
+            const path_segment *segment = &context->paths[index].segments[level];
+            if ((active & (1UL << index)) && (segment->type == path_key)
+                && (segment->key_length == key_length) && (memcmp(segment->key, key, key_length) == 0))
+            {
+                matching |= 1UL << index;
+            }
         }
 
-        if (i < 3)
+        /* parse the value */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!extract_value(context, input_buffer, level + 1, matching, element))
         {
-            /* shift left to make place for the next nibble */
-            h = h << 4;
+            return false;
+        }
+        if (context->stopped)
+        {
+            return true;
         }
+        buffer_skip_whitespace(input_buffer);
     }
+    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
 
-    return h;
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '}'))
+    {
+        return false; /* expected end of object */
+    }
+
+success:
+    input_buffer->depth--;
+    input_buffer->offset++;
+
+    return true;
 }
 
-/* converts a UTF-16 literal to UTF-8
- * A literal can be one or two sequences of the form \uXXXX */
-static unsigned char utf16_literal_to_utf8(const unsigned char * const input_pointer, const unsigned char * const input_end, unsigned char **output_pointer)
+/* walk an array, descending only into elements selected by one of the active paths */
+static cJSON_bool extract_array(extract_context * const context, parse_buffer * const input_buffer, const size_t level, const unsigned long active)
 {
-    long unsigned int codepoint = 0;
-    unsigned int first_code = 0;
-    const unsigned char *first_sequence = input_pointer;
-    unsigned char utf8_length = 0;
-    unsigned char utf8_position = 0;
-    unsigned char sequence_length = 0;
-    unsigned char first_byte_mark = 0;
+    size_t array_index = 0;
 
-    if ((input_end - first_sequence) < 6)
+    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
-        /* input ends unexpectedly */
-        goto fail;
+        return false; /* to deeply nested */
     }
+    input_buffer->depth++;
 
-    /* get the first utf16 sequence */
-    first_code = parse_hex4(first_sequence + 2);
-
-    /* check that the code is valid */
-    if (((first_code >= 0xDC00) && (first_code <= 0xDFFF)))
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ']'))
     {
-        goto fail;
+        goto success; /* empty array */
     }
 
-    /* UTF16 surrogate pair */
-    if ((first_code >= 0xD800) && (first_code <= 0xDBFF))
+    /* step back to character in front of the first element */
+    input_buffer->offset--;
+    do
     {
-        const unsigned char *second_sequence = first_sequence + 6;
-        unsigned int second_code = 0;
-        sequence_length = 12; /* \uXXXX\uXXXX */
+        unsigned long matching = 0;
+        int index = 0;
 
-        if ((input_end - second_sequence) < 6)
+        for (index = 0; index < context->path_count; index++)
         {
-            /* input ends unexpectedly */
-            goto fail;
+            const path_segment *segment = &context->paths[index].segments[level];
+            if ((active & (1UL << index))
+                && ((segment->type == path_any) || ((segment->type == path_index) && (segment->index == array_index))))
+            {
+                matching |= 1UL << index;
+            }
         }
 
-        if ((second_sequence[0] != '\\') || (second_sequence[1] != 'u'))
+        /* parse next value */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!extract_value(context, input_buffer, level + 1, matching, (int)array_index))
         {
-            /* missing second half of the surrogate pair */
-            goto fail;
+            return false;
         }
-
-        /* get the second utf16 sequence */
-        second_code = parse_hex4(second_sequence + 2);
-        /* check that the code is valid */
-        if ((second_code < 0xDC00) || (second_code > 0xDFFF))
+        if (context->stopped)
         {
-            /* invalid second half of the surrogate pair */
-            goto fail;
-        }
-
-
-        /* calculate the unicode codepoint from the surrogate pair */
-        codepoint = 0x10000 + (((first_code & 0x3FF) << 10) | (second_code & 0x3FF));
-    }
-    else
-    {
-        sequence_length = 6; /* \uXXXX */
-        codepoint = first_code;
-    }
-
-    /* encode as UTF-8
-     * takes at maximum 4 bytes to encode:
-     * 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
-    if (codepoint < 0x80)
-    {
-        /* normal ascii, encoding 0xxxxxxx */
-        utf8_length = 1;
-    }
-    else if (codepoint < 0x800)
-    {
-        /* two bytes, encoding 110xxxxx 10xxxxxx */
-        utf8_length = 2;
-        first_byte_mark = 0xC0; /* 11000000 */
-    }
-    else if (codepoint < 0x10000)
-    {
-        /* three bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx */
-        utf8_length = 3;
-        first_byte_mark = 0xE0; /* 11100000 */
-    }
-    else if (codepoint <= 0x10FFFF)
-    {
-        /* four bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx 10xxxxxx */
-        utf8_length = 4;
-        first_byte_mark = 0xF0; /* 11110000 */
-    }
-    else
-    {
-        /* invalid unicode codepoint */
-        goto fail;
-    }
-
-    /* encode as utf8 */
-    for (utf8_position = (unsigned char)(utf8_length - 1); utf8_position > 0; utf8_position--)
-    {
-        /* 10xxxxxx */
-        (*output_pointer)[utf8_position] = (unsigned char)((codepoint | 0x80) & 0xBF);
-        codepoint >>= 6;
-    }
-    /* encode first byte */
-    if (utf8_length > 1)
-    {
-        (*output_pointer)[0] = (unsigned char)((codepoint | first_byte_mark) & 0xFF);
+            return true;
+        }
+        buffer_skip_whitespace(input_buffer);
+        array_index++;
     }
-    else
+    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ']'))
     {
-        (*output_pointer)[0] = (unsigned char)(codepoint & 0x7F);
+        return false; /* expected end of array */
     }
 
-    *output_pointer += utf8_length;
-
-    return sequence_length;
+success:
+    input_buffer->depth--;
+    input_buffer->offset++;
 
-fail:
-    return 0;
+    return true;
 }
 
-/* Parse the input text into an unescaped cinput, and populate item. */
-static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
+/* parse the value if a path ends here, descend if a path continues, skip it otherwise */
+static cJSON_bool extract_value(extract_context * const context, parse_buffer * const input_buffer, const size_t level, const unsigned long active, const int element)
 {
-    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
-    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
-    unsigned char *output_pointer = NULL;
-    unsigned char *output = NULL;
+    unsigned long complete = 0;
+    unsigned long deeper = 0;
+    int index = 0;
 
-    /* not a string */
-    if (buffer_at_offset(input_buffer)[0] != '\"')
+    for (index = 0; index < context->path_count; index++)
     {
-        goto fail;
+        if (active & (1UL << index))
+        {
+            if (context->paths[index].count == level)
+            {
+                complete |= 1UL << index;
+            }
+            else
+            {
+                deeper |= 1UL << index;
+            }
+        }
     }
 
+    if (complete)
     {
-        /* calculate approximate size of the output (overestimate) */
-        size_t allocation_length = 0;
-        size_t skipped_bytes = 0;
-        while (((size_t)(input_end - input_buffer->content) < input_buffer->length) && (*input_end != '\"'))
+        /* the requested value itself is materialized, it only lives for the duration of the callbacks */
+        cJSON value;
+        memset(&value, '\0', sizeof(value));
+        if (input_buffer->arena == NULL)
+        {
+            /* one arena per extraction instead of an allocation per materialized string */
+            input_buffer->arena = cJSON_CreateArena(0);
+        }
+        if (!parse_value(&value, input_buffer))
+        {
+            return false;
+        }
+        for (index = 0; (index < context->path_count) && !context->stopped; index++)
         {
-            /* is escape sequence */
-            if (input_end[0] == '\\')
+            if ((complete & (1UL << index)) && !context->callback(index, element, &value, context->userdata))
             {
-                if ((size_t)(input_end + 1 - input_buffer->content) >= input_buffer->length)
-                {
-                    /* prevent buffer overflow when last input character is a backslash */
-                    goto fail;
-                }
-                skipped_bytes++;
-                input_end++;
+                context->stopped = true;
             }
-            input_end++;
         }
-        if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end != '\"'))
+        if (value.child != NULL)
         {
-            goto fail; /* string ended unexpectedly */
+            parse_delete(input_buffer, value.child);
         }
-
-        /* This is at most how much we need for the output */
-        allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
-        if (output == NULL)
+        if (value.valuestring != NULL)
         {
-            goto fail; /* allocation failure */
+            parse_deallocate(input_buffer, value.valuestring);
         }
+        cJSON_ResetArena(input_buffer->arena);
+        return true;
     }
 
-    output_pointer = output;
-    /* loop through the string literal */
-    while (input_pointer < input_end)
+    if ((deeper != 0) && can_access_at_index(input_buffer, 0))
     {
-        if (*input_pointer != '\\')
+        if (buffer_at_offset(input_buffer)[0] == '{')
         {
-            *output_pointer++ = *input_pointer++;
+            return extract_object(context, input_buffer, level, deeper, element);
         }
-        /* escape sequence */
-        else
+        if (buffer_at_offset(input_buffer)[0] == '[')
         {
-            unsigned char sequence_length = 2;
-            if ((input_end - input_pointer) < 1)
-            {
-                goto fail;
-            }
+            return extract_array(context, input_buffer, level, deeper);
+        }
+    }
 
-            switch (input_pointer[1])
-            {
-                case 'b':
-                    *output_pointer++ = '\b';
-                    break;
-                case 'f':
-                    *output_pointer++ = '\f';
-                    break;
-                case 'n':
-                    *output_pointer++ = '\n';
-                    break;
-                case 'r':
-                    *output_pointer++ = '\r';
-                    break;
-                case 't':
-                    *output_pointer++ = '\t';
-                    break;
-                case '\"':
-                case '\\':
-                case '/':
-                    *output_pointer++ = input_pointer[1];
-                    break;
+    return skip_value(input_buffer);
+}
 
-                /* UTF-16 literal */
-                case 'u':
-                    sequence_length = utf16_literal_to_utf8(input_pointer, input_end, &output_pointer);
-                    if (sequence_length == 0)
-                    {
-                        /* failed to convert UTF16-literal to UTF-8 */
-                        goto fail;
-                    }
-                    break;
+CJSON_PUBLIC(cJSON_bool) cJSON_ExtractPaths(const char *value, size_t buffer_length, const char * const *paths, int path_count, cJSON_PathCallback callback, void *userdata)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, NULL, NULL };
+    cJSON_bool result = true;
+    compiled_path compiled[PATH_MAX_PATHS];
+    extract_context context;
+    unsigned long active = 0;
+    int index = 0;
 
-                default:
-                    goto fail;
-            }
-            input_pointer += sequence_length;
+    /* reset error position */
+    global_error.json = NULL;
+    global_error.position = 0;
+
+    if ((value == NULL) || (buffer_length == 0) || (paths == NULL) || (callback == NULL)
+        || (path_count <= 0) || (path_count > PATH_MAX_PATHS))
+    {
+        return false;
+    }
+
+    for (index = 0; index < path_count; index++)
+    {
+        if ((paths[index] == NULL) || !compile_path(paths[index], &compiled[index]))
+        {
+            return false;
         }
+        active |= 1UL << index;
     }
 
-    /* zero terminate the output */
-    *output_pointer = '\0';
+    context.paths = compiled;
+    context.path_count = path_count;
+    context.callback = callback;
+    context.userdata = userdata;
+    context.stopped = false;
 
-    item->type = cJSON_String;
-    item->valuestring = (char*)output;
+    buffer.content = (const unsigned char*)value;
+    buffer.length = buffer_length;
+    buffer.offset = 0;
+    buffer.hooks = global_hooks;
 
-    input_buffer->offset = (size_t) (input_end - input_buffer->content);
-    input_buffer->offset++;
+    if (!extract_value(&context, buffer_skip_whitespace(skip_utf8_bom(&buffer)), 0, active, -1))
+    {
+        global_error.json = (const unsigned char*)value;
+        global_error.position = (buffer.offset < buffer.length) ? buffer.offset : buffer.length - 1;
+        result = false;
+    }
+    cJSON_DeleteArena(buffer.arena);
 
-    return true;
+    return result;
+}
 
-fail:
-    if (output != NULL)
+/* Read-only tape representation (cJSON_ParseTape) */
+typedef struct
+{
+    int type; /* cJSON_False ... cJSON_Object */
+    cJSON_bool escaped; /* the string contains escape sequences */
+    cJSON_bool key_escaped; /* the key contains escape sequences */
+    size_t offset; /* start of the value in the text, strings start after the opening quote */
+    size_t length; /* length of the value text, strings without the quotes */
+    size_t key_offset; /* key of an object member, without the quotes */
+    size_t key_length;
+    size_t next; /* index of the token following this value and all of its children */
+    size_t count; /* number of children of an array or object */
+    double number;
+} tape_token;
+
+#define TAPE_INITIAL_CAPACITY 32
+
+struct cJSON_Tape
+{
+    const unsigned char *json;
+    size_t length;
+    tape_token *tokens;
+    size_t count;
+    size_t capacity;
+};
+
+/* append a token, returns its index. Tokens may move when the tape grows, so they are addressed by index. */
+static cJSON_bool tape_push(cJSON_Tape * const tape, size_t * const position)
+{
+    if (tape->count == tape->capacity)
     {
-        input_buffer->hooks.deallocate(output);
+        tape_token *tokens = NULL;
+        size_t capacity = tape->capacity * 2;
+        if ((capacity <= tape->capacity) || (capacity > ((size_t)-1) / sizeof(tape_token)))
+        {
+            return false;
+        }
+        if (global_hooks.reallocate != NULL)
+        {
+            tokens = (tape_token*)global_hooks.reallocate(tape->tokens, capacity * sizeof(tape_token));
+            if (tokens == NULL)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            tokens = (tape_token*)global_hooks.allocate(capacity * sizeof(tape_token));
+            if (tokens == NULL)
+            {
+                return false;
+            }
+            memcpy(tokens, tape->tokens, tape->count * sizeof(tape_token));
+            global_hooks.deallocate(tape->tokens);
+        }
+        tape->tokens = tokens;
+        tape->capacity = capacity;
     }
 
-    if (input_pointer != NULL)
+    memset(&tape->tokens[tape->count], '\0', sizeof(tape_token));
+    *position = tape->count++;
+
+    return true;
+}
+
+/* validate a string and record where its text is, the buffer has to point at the opening quote */
+static cJSON_bool tape_string(parse_buffer * const input_buffer, size_t * const offset, size_t * const length, cJSON_bool * const escaped)
+{
+    const unsigned char *end = input_buffer->content + input_buffer->length;
+    const unsigned char *start = buffer_at_offset(input_buffer) + 1;
+    const unsigned char *pointer = find_quote_or_backslash(start, end);
+    cJSON item;
+
+    *offset = (size_t)(start - input_buffer->content);
+    if ((pointer < end) && (*pointer == '\"'))
+    {
+        /* the common case: nothing to decode */
+        *length = (size_t)(pointer - start);
+        *escaped = false;
+        input_buffer->offset = (size_t)(pointer + 1 - input_buffer->content);
+        return true;
+    }
+
+    /* escape sequences are checked by decoding the string once into the scratch arena,
+     * an unterminated string fails there with the same error position as in cJSON_Parse */
+    memset(&item, '\0', sizeof(item));
+    if (input_buffer->arena == NULL)
     {
-        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+        input_buffer->arena = cJSON_CreateArena(0);
+    }
+    if (!parse_string(&item, input_buffer))
+    {
+        return false;
     }
+    cJSON_ResetArena(input_buffer->arena);
+    *length = input_buffer->offset - *offset - 1;
+    *escaped = true;
 
-    return false;
+    return true;
 }
 
-/* Render the cstring provided to an escaped version that can be printed. */
-static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffer * const output_buffer)
+static cJSON_bool tape_value(cJSON_Tape * const tape, parse_buffer * const input_buffer, size_t * const position);
+
+/* parse the members of an array or object into the tokens following the container token */
+static cJSON_bool tape_children(cJSON_Tape * const tape, parse_buffer * const input_buffer, const size_t position, const cJSON_bool object)
 {
-    const unsigned char *input_pointer = NULL;
-    unsigned char *output = NULL;
-    unsigned char *output_pointer = NULL;
-    size_t output_length = 0;
-    /* numbers of additional characters needed for escaping */
-    size_t escape_characters = 0;
+    const unsigned char close = object ? '}' : ']';
+    size_t count = 0;
 
-    if (output_buffer == NULL)
+    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
-        return false;
+        return false; /* to deeply nested */
     }
+    input_buffer->depth++;
 
-    /* empty string */
-    if (input == NULL)
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == close))
     {
-        output = ensure(output_buffer, sizeof("\"\""));
-        if (output == NULL)
+        goto success; /* empty array or object */
+    }
+
+    /* step back to character in front of the first element */
+    input_buffer->offset--;
+    do
+    {
+        size_t key_offset = 0;
+        size_t key_length = 0;
+        cJSON_bool key_escaped = false;
+        size_t child = 0;
+
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (object)
         {
-            return false;
+            if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '\"'))
+            {
+                /* parse_string reports the character after the missing quote */
+                input_buffer->offset++;
+                return false; /* failed to parse name */
+            }
+            if (!tape_string(input_buffer, &key_offset, &key_length, &key_escaped))
+            {
+                return false;
+            }
+            buffer_skip_whitespace(input_buffer);
+            if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
+            {
+                return false; /* invalid object */
+            }
+            input_buffer->offset++;
+            buffer_skip_whitespace(input_buffer);
         }
-        strcpy((char*)output, "\"\"");
 
-        return true;
+        if (!tape_value(tape, input_buffer, &child))
+        {
+            return false;
+        }
+        tape->tokens[child].key_offset = key_offset;
+        tape->tokens[child].key_length = key_length;
+        tape->tokens[child].key_escaped = key_escaped;
+        count++;
+        buffer_skip_whitespace(input_buffer);
     }
+    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
 
-    /* set "flag" to 1 if something needs to be escaped */
-    for (input_pointer = input; *input_pointer; input_pointer++)
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != close))
     {
-        switch (*input_pointer)
-        {
-            case '\"':
-            case '\\':
-            case '\b':
-            case '\f':
-            case '\n':
-            case '\r':
-            case '\t':
-                /* one character escape sequence */
-                escape_characters++;
-                break;
-            default:
-                if (*input_pointer < 32)
-                {
-                    /* UTF-16 escape sequence uXXXX */
-                    escape_characters += 5;
-                }
-                break;
-        }
+        return false; /* expected end of array or object */
     }
-    output_length = (size_t)(input_pointer - input) + escape_characters;
 
-    output = ensure(output_buffer, output_length + sizeof("\"\""));
-    if (output == NULL)
+success:
+    input_buffer->depth--;
+    input_buffer->offset++;
+    tape->tokens[position].count = count;
+
+    return true;
+}
+
+/* append the token of a value and, for arrays and objects, the tokens of its children */
+static cJSON_bool tape_value(cJSON_Tape * const tape, parse_buffer * const input_buffer, size_t * const position)
+{
+    tape_token *token = NULL;
+    size_t start = input_buffer->offset;
+
+    if (cannot_access_at_index(input_buffer, 0) || !tape_push(tape, position))
     {
         return false;
     }
+    token = &tape->tokens[*position];
+    token->offset = start;
 
-    /* no characters have to be escaped */
-    if (escape_characters == 0)
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "null", 4) == 0))
     {
-        output[0] = '\"';
-        memcpy(output + 1, input, output_length);
-        output[output_length + 1] = '\"';
-        output[output_length + 2] = '\0';
-
+        token->type = cJSON_NULL;
+        input_buffer->offset += 4;
+    }
+    else if (can_read(input_buffer, 5) && (strncmp((const char*)buffer_at_offset(input_buffer), "false", 5) == 0))
+    {
+        token->type = cJSON_False;
+        input_buffer->offset += 5;
+    }
+    else if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "true", 4) == 0))
+    {
+        token->type = cJSON_True;
+        input_buffer->offset += 4;
+    }
+    else if (buffer_at_offset(input_buffer)[0] == '\"')
+    {
+        token->type = cJSON_String;
+        if (!tape_string(input_buffer, &token->offset, &token->length, &token->escaped))
+        {
+            return false;
+        }
+        tape->tokens[*position].next = tape->count;
         return true;
     }
-
-    output[0] = '\"';
-    output_pointer = output + 1;
-    /* copy the string */
-    for (input_pointer = input; *input_pointer != '\0'; (void)input_pointer++, output_pointer++)
+    else if ((buffer_at_offset(input_buffer)[0] == '-') || ((buffer_at_offset(input_buffer)[0] >= '0') && (buffer_at_offset(input_buffer)[0] <= '9')))
     {
-        if ((*input_pointer > 31) && (*input_pointer != '\"') && (*input_pointer != '\\'))
+        cJSON item;
+        memset(&item, '\0', sizeof(item));
+        if (!parse_number(&item, input_buffer))
         {
-            /* normal character, copy */
-            *output_pointer = *input_pointer;
+            return false;
         }
-        else
+        token->type = cJSON_Number;
+        token->number = item.valuedouble;
+    }
+    else if ((buffer_at_offset(input_buffer)[0] == '[') || (buffer_at_offset(input_buffer)[0] == '{'))
+    {
+        cJSON_bool object = (buffer_at_offset(input_buffer)[0] == '{');
+        token->type = object ? cJSON_Object : cJSON_Array;
+        /* the token can move while the children are appended */
+        if (!tape_children(tape, input_buffer, *position, object))
         {
-            /* character needs to be escaped */
-            *output_pointer++ = '\\';
-            switch (*input_pointer)
-            {
-                case '\\':
-                    *output_pointer = '\\';
-                    break;
-                case '\"':
-                    *output_pointer = '\"';
-                    break;
-                case '\b':
-                    *output_pointer = 'b';
-                    break;
-                case '\f':
-                    *output_pointer = 'f';
-                    break;
-                case '\n':
-                    *output_pointer = 'n';
-                    break;
-                case '\r':
-                    *output_pointer = 'r';
-                    break;
-                case '\t':
-                    *output_pointer = 't';
-                    break;
-                default:
-                    /* escape and print as unicode codepoint */
-                    sprintf((char*)output_pointer, "u%04x", *input_pointer);
-                    output_pointer += 4;
-                    break;
-            }
+            return false;
         }
     }
-    output[output_length + 1] = '\"';
-    output[output_length + 2] = '\0';
+    else
+    {
+        return false;
+    }
+
+    tape->tokens[*position].length = input_buffer->offset - start;
+    tape->tokens[*position].next = tape->count;
 
     return true;
 }
 
-/* Invoke print_string_ptr (which is useful) on an item. */
-static cJSON_bool print_string(const cJSON * const item, printbuffer * const p)
+CJSON_PUBLIC(cJSON_Tape *) cJSON_ParseTape(const char *value, size_t buffer_length)
 {
-    return print_string_ptr((unsigned char*)item->valuestring, p);
-}
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, NULL, NULL };
+    cJSON_Tape *tape = NULL;
+    size_t position = 0;
 
-/* Predeclare these prototypes. */
-static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer);
-static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer);
-static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer);
+    /* reset error position */
+    global_error.json = NULL;
+    global_error.position = 0;
 
-/* Utility to jump whitespace and cr/lf */
-static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
-{
-    if ((buffer == NULL) || (buffer->content == NULL))
+    if ((value == NULL) || (buffer_length == 0))
     {
         return NULL;
     }
 
-    if (cannot_access_at_index(buffer, 0))
+    tape = (cJSON_Tape*)global_hooks.allocate(sizeof(cJSON_Tape));
+    if (tape == NULL)
     {
-        return buffer;
+        return NULL;
     }
-
-    while (can_access_at_index(buffer, 0) && (buffer_at_offset(buffer)[0] <= 32))
+    tape->json = (const unsigned char*)value;
+    tape->length = buffer_length;
+    tape->count = 0;
+    /* start small, the tape doubles as the tokens come */
+    tape->capacity = TAPE_INITIAL_CAPACITY;
+    tape->tokens = (tape_token*)global_hooks.allocate(tape->capacity * sizeof(tape_token));
+    if (tape->tokens == NULL)
     {
-       buffer->offset++;
+        global_hooks.deallocate(tape);
+        return NULL;
     }
 
-    if (buffer->offset == buffer->length)
+    buffer.content = (const unsigned char*)value;
+    buffer.length = buffer_length;
+    buffer.offset = 0;
+    buffer.hooks = global_hooks;
+
+    if (!tape_value(tape, buffer_skip_whitespace(skip_utf8_bom(&buffer)), &position))
     {
-        buffer->offset--;
+        global_error.json = (const unsigned char*)value;
+        global_error.position = (buffer.offset < buffer.length) ? buffer.offset : buffer.length - 1;
+        cJSON_DeleteTape(tape);
+        tape = NULL;
     }
+    cJSON_DeleteArena(buffer.arena);
 
-    return buffer;
+    return tape;
 }
 
-/* skip the UTF-8 BOM (byte order mark) if it is at the beginning of a buffer */
-static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
+CJSON_PUBLIC(void) cJSON_DeleteTape(cJSON_Tape *tape)
 {
-    if ((buffer == NULL) || (buffer->content == NULL) || (buffer->offset != 0))
+    if (tape != NULL)
     {
-        return NULL;
+        global_hooks.deallocate(tape->tokens);
+        global_hooks.deallocate(tape);
     }
+}
 
-    if (can_access_at_index(buffer, 4) && (strncmp((const char*)buffer_at_offset(buffer), "\xEF\xBB\xBF", 3) == 0))
+static const tape_token *tape_token_at(const cJSON_TapeIterator iterator)
+{
+    if ((iterator.tape == NULL) || (iterator.position >= iterator.end))
     {
-        buffer->offset += 3;
+        return NULL;
     }
 
-    return buffer;
+    return &iterator.tape->tokens[iterator.position];
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+CJSON_PUBLIC(cJSON_TapeIterator) cJSON_TapeRoot(const cJSON_Tape *tape)
 {
-    size_t buffer_length;
+    cJSON_TapeIterator iterator;
+    iterator.tape = tape;
+    iterator.position = 0;
+    iterator.end = (tape != NULL) ? tape->count : 0;
 
-    if (NULL == value)
+    return iterator;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_TapeIsValid(cJSON_TapeIterator iterator)
+{
+    return tape_token_at(iterator) != NULL;
+}
+
+CJSON_PUBLIC(int) cJSON_TapeType(cJSON_TapeIterator iterator)
+{
+    const tape_token *token = tape_token_at(iterator);
+    return (token != NULL) ? token->type : cJSON_Invalid;
+}
+
+CJSON_PUBLIC(cJSON_TapeIterator) cJSON_TapeChild(cJSON_TapeIterator iterator)
+{
+    const tape_token *token = tape_token_at(iterator);
+    if (token == NULL)
     {
-        return NULL;
+        return iterator;
     }
 
-    /* Adding null character size due to require_null_terminated. */
-    buffer_length = strlen(value) + sizeof("");
+    /* the children follow their container directly and end where the container's sibling starts */
+    iterator.end = token->next;
+    iterator.position = ((token->type & (cJSON_Array | cJSON_Object)) && (token->count > 0)) ? iterator.position + 1 : iterator.end;
 
-    return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
+    return iterator;
 }
 
-/* Parse an object - create a new root, and populate. */
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+CJSON_PUBLIC(cJSON_TapeIterator) cJSON_TapeNext(cJSON_TapeIterator iterator)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
-    cJSON *item = NULL;
+    const tape_token *token = tape_token_at(iterator);
+    if (token != NULL)
+    {
+        iterator.position = token->next;
+    }
 
-    /* reset error position */
-    global_error.json = NULL;
-    global_error.position = 0;
+    return iterator;
+}
 
-    if (value == NULL || 0 == buffer_length)
+CJSON_PUBLIC(int) cJSON_TapeGetSize(cJSON_TapeIterator iterator)
+{
+    const tape_token *token = tape_token_at(iterator);
+    if ((token == NULL) || !(token->type & (cJSON_Array | cJSON_Object)))
     {
-        goto fail;
+        return 0;
     }
 
-    buffer.content = (const unsigned char*)value;
-    buffer.length = buffer_length; 
-    buffer.offset = 0;
-    buffer.hooks = global_hooks;
+    return (int)token->count;
+}
 
-    item = cJSON_New_Item(&global_hooks);
-    if (item == NULL) /* memory fail */
+CJSON_PUBLIC(cJSON_TapeIterator) cJSON_TapeGetArrayItem(cJSON_TapeIterator array, int index)
+{
+    cJSON_TapeIterator element = cJSON_TapeChild(array);
+
+    if (index < 0)
     {
-        goto fail;
+        element.position = element.end;
+        return element;
     }
 
-    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
+    while ((index > 0) && cJSON_TapeIsValid(element))
     {
-        /* parse failure. ep is set. */
-        goto fail;
+        element = cJSON_TapeNext(element);
+        index--;
     }
 
-    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
-    if (require_null_terminated)
+    return element;
+}
+
+CJSON_PUBLIC(cJSON_TapeIterator) cJSON_TapeGetObjectItem(cJSON_TapeIterator object, const char *string)
+{
+    cJSON_TapeIterator member;
+    size_t length = 0;
+
+    if (cJSON_TapeType(object) != cJSON_Object)
     {
-        buffer_skip_whitespace(&buffer);
-        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
+        member = object;
+        member.position = member.end;
+        return member;
+    }
+
+    member = cJSON_TapeChild(object);
+    if (string == NULL)
+    {
+        member.position = member.end;
+        return member;
+    }
+
+    /* keys are compared without decoding escape sequences, like in cJSON_ExtractPaths */
+    length = strlen(string);
+    while (cJSON_TapeIsValid(member))
+    {
+        const tape_token *token = &member.tape->tokens[member.position];
+        if ((token->key_length == length) && (memcmp(member.tape->json + token->key_offset, string, length) == 0))
         {
-            goto fail;
+            break;
         }
+        member = cJSON_TapeNext(member);
     }
-    if (return_parse_end)
+
+    return member;
+}
+
+CJSON_PUBLIC(const char *) cJSON_TapeGetKey(cJSON_TapeIterator iterator, size_t *length)
+{
+    const tape_token *token = tape_token_at(iterator);
+    if ((token == NULL) || (token->key_offset == 0))
     {
-        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+        return NULL;
     }
 
-    return item;
-
-fail:
-    if (item != NULL)
+    if (length != NULL)
     {
-        cJSON_Delete(item);
+        *length = token->key_length;
     }
 
-    if (value != NULL)
+    return (const char*)(iterator.tape->json + token->key_offset);
+}
+
+CJSON_PUBLIC(double) cJSON_TapeGetNumber(cJSON_TapeIterator iterator)
+{
+    const tape_token *token = tape_token_at(iterator);
+    if ((token == NULL) || (token->type != cJSON_Number))
     {
-        error local_error;
-        local_error.json = (const unsigned char*)value;
-        local_error.position = 0;
+        return (double) NAN;
+    }
 
-        if (buffer.offset < buffer.length)
-        {
-            local_error.position = buffer.offset;
-        }
-        else if (buffer.length > 0)
-        {
-            local_error.position = buffer.length - 1;
-        }
+    return token->number;
+}
 
-        if (return_parse_end != NULL)
+CJSON_PUBLIC(size_t) cJSON_TapeGetString(cJSON_TapeIterator iterator, char *buffer, size_t size)
+{
+    const tape_token *token = tape_token_at(iterator);
+    const unsigned char *text = NULL;
+    size_t length = 0;
+    cJSON item;
+
+    if ((buffer != NULL) && (size > 0))
+    {
+        buffer[0] = '\0';
+    }
+    if ((token == NULL) || (token->type != cJSON_String))
+    {
+        return 0;
+    }
+
+    memset(&item, '\0', sizeof(item));
+    text = iterator.tape->json + token->offset;
+    length = token->length;
+    if (token->escaped)
+    {
+        /* only strings with escape sequences are decoded, the text was validated by the parse */
+        parse_buffer string_buffer = { 0, 0, 0, 0, { 0, 0, 0 }, NULL, NULL };
+        string_buffer.content = iterator.tape->json;
+        string_buffer.length = iterator.tape->length;
+        string_buffer.offset = token->offset - 1;
+        string_buffer.hooks = global_hooks;
+        if (!parse_string(&item, &string_buffer))
         {
-            *return_parse_end = (const char*)local_error.json + local_error.position;
+            return 0;
         }
+        text = (const unsigned char*)item.valuestring;
+        length = strlen(item.valuestring);
+    }
 
-        global_error = local_error;
+    if ((buffer != NULL) && (size > 0))
+    {
+        size_t copy = (length < size) ? length : size - 1;
+        memcpy(buffer, text, copy);
+        buffer[copy] = '\0';
+    }
+    if (item.valuestring != NULL)
+    {
+        global_hooks.deallocate(item.valuestring);
     }
 
-    return NULL;
+    return length;
 }
 
-/* Default options for cJSON_Parse */
-CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+CJSON_PUBLIC(const char *) cJSON_TapeGetRaw(cJSON_TapeIterator iterator, size_t *length)
 {
-    return cJSON_ParseWithOpts(value, 0, 0);
-}
+    const tape_token *token = tape_token_at(iterator);
+    if (token == NULL)
+    {
+        return NULL;
+    }
 
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
-{
-    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+    if (length != NULL)
+    {
+        *length = token->length;
+    }
+
+    return (const char*)(iterator.tape->json + token->offset);
 }
 
 #define cjson_min(a, b) (((a) < (b)) ? (a) : (b))
@@ -1472,7 +4451,7 @@ static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buf
     do
     {
         /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
+        cJSON *new_item = parse_new_item(input_buffer);
         if (new_item == NULL)
         {
             goto fail; /* allocation failure */
@@ -1517,6 +4496,10 @@ success:
 
     item->type = cJSON_Array;
     item->child = head;
+    if (!parse_uses_global_hooks(input_buffer))
+    {
+        item->index = &no_index;
+    }
 
     input_buffer->offset++;
 
@@ -1525,7 +4508,7 @@ success:
 fail:
     if (head != NULL)
     {
-        cJSON_Delete(head);
+        parse_delete(input_buffer, head);
     }
 
     return false;
@@ -1630,7 +4613,7 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
     do
     {
         /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
+        cJSON *new_item = parse_new_item(input_buffer);
         if (new_item == NULL)
         {
             goto fail; /* allocation failure */
@@ -1693,6 +4676,10 @@ success:
 
     item->type = cJSON_Object;
     item->child = head;
+    if (!parse_uses_global_hooks(input_buffer))
+    {
+        item->index = &no_index;
+    }
 
     input_buffer->offset++;
     return true;
@@ -1700,7 +4687,7 @@ success:
 fail:
     if (head != NULL)
     {
-        cJSON_Delete(head);
+        parse_delete(input_buffer, head);
     }
 
     return false;
@@ -1831,6 +4818,11 @@ CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
         return 0;
     }
 
+    if ((array->index != NULL) && (array->index->items != NULL))
+    {
+        return (int)array->index->count;
+    }
+
     child = array->child;
 
     while(child != NULL)
@@ -1853,6 +4845,11 @@ static cJSON* get_array_item(const cJSON *array, size_t index)
         return NULL;
     }
 
+    if ((array->index != NULL) && (array->index->items != NULL))
+    {
+        return (index < array->index->count) ? array->index->items[index] : NULL;
+    }
+
     current_child = array->child;
     while ((current_child != NULL) && (index > 0))
     {
@@ -1885,6 +4882,10 @@ static cJSON *get_object_item(const cJSON * const object, const char * const nam
     current_element = object->child;
     if (case_sensitive)
     {
+        if ((object->index != NULL) && (object->index->slots != NULL))
+        {
+            return index_lookup(object->index, name);
+        }
         while ((current_element != NULL) && (current_element->string != NULL) && (strcmp(name, current_element->string) != 0))
         {
             current_element = current_element->next;
@@ -1920,6 +4921,36 @@ CJSON_PUBLIC(cJSON_bool) cJSON_HasObjectItem(const cJSON *object, const char *st
     return cJSON_GetObjectItem(object, string) ? 1 : 0;
 }
 
+CJSON_PUBLIC(cJSON_bool) cJSON_IndexArray(cJSON *array)
+{
+    /* references share the children of another item and don't see its changes */
+    if ((array == NULL) || ((array->type & 0xFF) != cJSON_Array) || (array->type & cJSON_IsReference) || (array->index == &no_index))
+    {
+        return false;
+    }
+
+    return build_array_index(array);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_IndexObject(cJSON *object)
+{
+    /* references share the children of another item and don't see its changes */
+    if ((object == NULL) || ((object->type & 0xFF) != cJSON_Object) || (object->type & cJSON_IsReference) || (object->index == &no_index))
+    {
+        return false;
+    }
+
+    return build_object_index(object);
+}
+
+CJSON_PUBLIC(void) cJSON_InvalidateIndex(cJSON *object)
+{
+    if (object != NULL)
+    {
+        delete_index(object);
+    }
+}
+
 /* Utility for array list handling. */
 static void suffix_object(cJSON *prev, cJSON *item)
 {
@@ -1944,6 +4975,7 @@ static cJSON *create_reference(const cJSON *item, const internal_hooks * const h
 
     memcpy(reference, item, sizeof(cJSON));
     reference->string = NULL;
+    reference->index = NULL;
     reference->type |= cJSON_IsReference;
     reference->next = reference->prev = NULL;
     return reference;
@@ -1978,6 +5010,7 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
             array->child->prev = item;
         }
     }
+    index_append(array, item);
 
     return true;
 }
@@ -2180,7 +5213,7 @@ CJSON_PUBLIC(cJSON*) cJSON_AddArrayToObject(cJSON * const object, const char * c
     return NULL;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const item)
+static cJSON *detach_item(cJSON * const parent, cJSON * const item, const size_t position)
 {
     if ((parent == NULL) || (item == NULL))
     {
@@ -2212,10 +5245,16 @@ CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const it
     /* make sure the detached item doesn't point anywhere anymore */
     item->prev = NULL;
     item->next = NULL;
+    index_remove(parent, position, item);
 
     return item;
 }
 
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const item)
+{
+    return detach_item(parent, item, INDEX_UNKNOWN_POSITION);
+}
+
 CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromArray(cJSON *array, int which)
 {
     if (which < 0)
@@ -2223,7 +5262,7 @@ CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromArray(cJSON *array, int which)
         return NULL;
     }
 
-    return cJSON_DetachItemViaPointer(array, get_array_item(array, (size_t)which));
+    return detach_item(array, get_array_item(array, (size_t)which), (size_t)which);
 }
 
 CJSON_PUBLIC(void) cJSON_DeleteItemFromArray(cJSON *array, int which)
@@ -2282,10 +5321,11 @@ CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON
     {
         newitem->prev->next = newitem;
     }
+    index_insert(array, (size_t)which, newitem);
     return true;
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON * const item, cJSON * replacement)
+static cJSON_bool replace_item(cJSON * const parent, cJSON * const item, cJSON * replacement, const size_t position)
 {
     if ((parent == NULL) || (replacement == NULL) || (item == NULL))
     {
@@ -2327,6 +5367,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
         }
     }
 
+    index_replace(parent, position, item, replacement);
     item->next = NULL;
     item->prev = NULL;
     cJSON_Delete(item);
@@ -2334,6 +5375,11 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
     return true;
 }
 
+CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON * const item, cJSON * replacement)
+{
+    return replace_item(parent, item, replacement, INDEX_UNKNOWN_POSITION);
+}
+
 CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInArray(cJSON *array, int which, cJSON *newitem)
 {
     if (which < 0)
@@ -2341,7 +5387,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInArray(cJSON *array, int which, cJSON
         return false;
     }
 
-    return cJSON_ReplaceItemViaPointer(array, get_array_item(array, (size_t)which), newitem);
+    return replace_item(array, get_array_item(array, (size_t)which), newitem, (size_t)which);
 }
 
 static cJSON_bool replace_item_in_object(cJSON *object, const char *string, cJSON *replacement, cJSON_bool case_sensitive)
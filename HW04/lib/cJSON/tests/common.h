@@ -0,0 +1,35 @@
+/*
+  Minimal assertions for the cJSON test programs. Every failed check is reported with its location,
+  the program exits with the number of failures (0 = all passed).
+*/
+
+#ifndef cJSON_tests_common_h
+#define cJSON_tests_common_h
+
+#include <stdio.h>
+
+static int test_failures = 0;
+
+#define TEST_CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            test_failures++; \
+        } \
+    } while (0)
+
+#define TEST_CHECK_MESSAGE(condition, message) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            fprintf(stderr, "%s:%d: check failed: %s (%s)\n", __FILE__, __LINE__, #condition, message); \
+            test_failures++; \
+        } \
+    } while (0)
+
+#define TEST_RESULT() ((test_failures > 0) ? 1 : 0)
+
+#endif
@@ -0,0 +1,167 @@
+/*
+  Arena parse mode: arena trees have to match the trees of cJSON_Parse, a warm arena parses
+  without any allocation and a reset releases the whole tree at once.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cJSON.h"
+#include "common.h"
+
+static size_t allocations = 0;
+
+static void *CJSON_CDECL counting_malloc(size_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+static void CJSON_CDECL counting_free(void *pointer)
+{
+    free(pointer);
+}
+
+static const char *documents[] =
+{
+    "{\"title\": \"Moscow\", \"woeid\": 2122265, \"consolidated_weather\": [{\"id\": 1, \"weather_state_name\": \"Light \\\"Cloud\\\"\","
+    " \"applicable_date\": \"2021-05-01\", \"wind_speed\": 3.5, \"min_temp\": -1.5e0, \"max_temp\": 10.125}], \"sources\": []}",
+    "[1, 2.5, -3e10, true, false, null, \"\\u00e9\\ud83d\\ude00\", [], {}, [[[{\"a\": {\"b\": [\"c\"]}}]]]]",
+    "\"just a string\"",
+    "   42   ",
+    "{}"
+};
+
+static const char *invalid_documents[] =
+{
+    "{\"a\": }",
+    "[1, 2",
+    "{\"a\": \"unterminated}",
+    "[\"\\u12\"]",
+    "nul"
+};
+
+#define COUNT(array) (sizeof(array) / sizeof((array)[0]))
+
+static void check_matches_regular_parse(cJSON_Arena *arena)
+{
+    size_t index = 0;
+    for (index = 0; index < COUNT(documents); index++)
+    {
+        cJSON *expected = cJSON_Parse(documents[index]);
+        cJSON *actual = cJSON_ParseWithLengthArena(documents[index], strlen(documents[index]) + 1, arena);
+        char *expected_text = NULL;
+        char *actual_text = NULL;
+
+        TEST_CHECK(expected != NULL);
+        TEST_CHECK(actual != NULL);
+        if ((expected == NULL) || (actual == NULL))
+        {
+            cJSON_Delete(expected);
+            continue;
+        }
+
+        TEST_CHECK(cJSON_Compare(expected, actual, 1));
+        expected_text = cJSON_PrintUnformatted(expected);
+        actual_text = cJSON_PrintUnformatted(actual);
+        TEST_CHECK_MESSAGE(strcmp(expected_text, actual_text) == 0, documents[index]);
+
+        free(expected_text);
+        free(actual_text);
+        cJSON_Delete(expected);
+        cJSON_ResetArena(arena);
+    }
+}
+
+static void check_invalid_documents(cJSON_Arena *arena)
+{
+    size_t index = 0;
+    for (index = 0; index < COUNT(invalid_documents); index++)
+    {
+        TEST_CHECK_MESSAGE(cJSON_ParseWithLengthArena(invalid_documents[index], strlen(invalid_documents[index]), arena) == NULL, invalid_documents[index]);
+        TEST_CHECK(cJSON_GetErrorPtr() != NULL);
+        cJSON_ResetArena(arena);
+    }
+
+    /* the arena is still usable after failed parses */
+    check_matches_regular_parse(arena);
+}
+
+static char *large_document(size_t elements)
+{
+    size_t size = (elements * 160) + 16;
+    char *text = (char*)malloc(size);
+    size_t length = 0;
+    size_t index = 0;
+
+    length += (size_t)sprintf(text + length, "[");
+    for (index = 0; index < elements; index++)
+    {
+        length += (size_t)sprintf(text + length, "%s{\"id\": %lu, \"name\": \"element %lu\", \"value\": %lu.25, \"tags\": [\"a\", \"b\"]}",
+                                  (index > 0) ? "," : "", (unsigned long)index, (unsigned long)index, (unsigned long)index);
+    }
+    sprintf(text + length, "]");
+
+    return text;
+}
+
+static void check_warm_arena_does_not_allocate(void)
+{
+    cJSON_Hooks hooks;
+    cJSON_Arena *arena = NULL;
+    char *text = large_document(3000);
+    cJSON *tree = NULL;
+    size_t cold = 0;
+    size_t regular = 0;
+
+    hooks.malloc_fn = counting_malloc;
+    hooks.free_fn = counting_free;
+    cJSON_InitHooks(&hooks);
+
+    /* the regular parse allocates every node and string on its own */
+    allocations = 0;
+    tree = cJSON_Parse(text);
+    regular = allocations;
+    TEST_CHECK(tree != NULL);
+    cJSON_Delete(tree);
+
+    arena = cJSON_CreateArena(0);
+    allocations = 0;
+    tree = cJSON_ParseWithLengthArena(text, strlen(text), arena);
+    cold = allocations;
+    TEST_CHECK(tree != NULL);
+    TEST_CHECK(cJSON_GetArraySize(tree) == 3000);
+    printf("3000 elements: %lu allocations with malloc, %lu with a cold arena\n", (unsigned long)regular, (unsigned long)cold);
+    /* only whole blocks are allocated */
+    TEST_CHECK((cold * 50) < regular);
+
+    /* a reset arena reuses its blocks */
+    cJSON_ResetArena(arena);
+    allocations = 0;
+    tree = cJSON_ParseWithLengthArena(text, strlen(text), arena);
+    TEST_CHECK(tree != NULL);
+    TEST_CHECK(cJSON_GetArraySize(tree) == 3000);
+    TEST_CHECK(allocations == 0);
+
+    cJSON_DeleteArena(arena);
+    cJSON_InitHooks(NULL);
+    free(text);
+}
+
+int main(void)
+{
+    cJSON_Arena *arena = cJSON_CreateArena(64);
+
+    /* a tiny block size forces documents to span many blocks */
+    check_matches_regular_parse(arena);
+    check_invalid_documents(arena);
+    cJSON_DeleteArena(arena);
+
+    arena = cJSON_CreateArena(0);
+    check_matches_regular_parse(arena);
+    cJSON_DeleteArena(arena);
+
+    check_warm_arena_does_not_allocate();
+
+    return TEST_RESULT();
+}
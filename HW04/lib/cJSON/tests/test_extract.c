@@ -0,0 +1,193 @@
+/*
+  Path extraction: cJSON_ExtractPaths has to accept exactly what cJSON_Parse accepts, also in the parts
+  of the document it skips, and the extracted values have to print like the same values of cJSON_Parse.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cJSON.h"
+#include "common.h"
+
+static unsigned long random_state = 7;
+
+static unsigned long next_random(void)
+{
+    random_state = random_state * 1103515245UL + 12345UL;
+    return (random_state >> 8) & 0xffffff;
+}
+
+typedef struct
+{
+    const cJSON *tree;
+    const char *json;
+    int calls;
+} extract_state;
+
+/* the n-th member "a" of the root, the callback sees duplicates in document order */
+static const cJSON *root_member(const cJSON *tree, int number)
+{
+    const cJSON *child = NULL;
+
+    for (child = (tree != NULL) ? tree->child : NULL; child != NULL; child = child->next)
+    {
+        if ((child->string != NULL) && (strcmp(child->string, "a") == 0) && (number-- == 0))
+        {
+            return child;
+        }
+    }
+
+    return NULL;
+}
+
+static cJSON_bool check_value(int path_index, int element, const cJSON *value, void *userdata)
+{
+    extract_state *state = (extract_state*)userdata;
+    const cJSON *expected = root_member(state->tree, state->calls);
+
+    (void)path_index;
+    (void)element;
+    state->calls++;
+    if (expected != NULL)
+    {
+        char *expected_text = cJSON_PrintUnformatted(expected);
+        char *value_text = cJSON_PrintUnformatted(value);
+        TEST_CHECK_MESSAGE(strcmp(expected_text, value_text) == 0, state->json);
+        cJSON_free(expected_text);
+        cJSON_free(value_text);
+    }
+
+    return 1;
+}
+
+static void check_document(const char *json, size_t length)
+{
+    static const char * const paths[] = { "a" };
+    cJSON *tree = cJSON_ParseWithLength(json, length);
+    extract_state state;
+    cJSON_bool extracted;
+    int members = 0;
+
+    state.tree = tree;
+    state.json = json;
+    state.calls = 0;
+    extracted = cJSON_ExtractPaths(json, length, paths, 1, check_value, &state);
+
+    TEST_CHECK_MESSAGE(extracted == (tree != NULL), json);
+    if (extracted && (tree != NULL))
+    {
+        while (root_member(tree, members) != NULL)
+        {
+            members++;
+        }
+        TEST_CHECK_MESSAGE(state.calls == members, json);
+    }
+
+    cJSON_Delete(tree);
+}
+
+static void test_skipped_errors(void)
+{
+    static const char *documents[] =
+    {
+        "{\"a\":1,\"b\":foo}", "{\"a\":1,\"b\":[1,2,xyz]}", "{\"a\":1,\"b\":1.2.3e+-}", "{\"b\":{\"x\":nul},\"a\":1}",
+        "{\"a\":1,\"b\":\"\\q\"}", "{\"b\":[1 2],\"a\":1}", "{\"b\":{\"x\" 1},\"a\":1}", "{\"b\":[1,],\"a\":1}",
+        "{\"b\":{\"\\u12\":1},\"a\":1}", "{\"b\":\"\\ud800\",\"a\":1}", "{\"b\":-,\"a\":1}", "{\"b\":truefalse,\"a\":1}",
+        "{\"b\":{1:2},\"a\":1}", "{\"b\":[}],\"a\":1}", "{\"a\":1,\"b\":[\"ab\\",
+        /* the same documents without errors */
+        "{\"a\":1,\"b\":null}", "{\"a\":1,\"b\":[1,2,true]}", "{\"a\":1,\"b\":1.2e+3}", "{\"b\":{\"x\":null},\"a\":1}",
+        "{\"a\":1,\"b\":\"\\n\\u00e9\"}", "{\"b\":{\"\\u0041\":[{}, []]},\"a\":[1, {\"c\": \"d\"}]}"
+    };
+    size_t i;
+
+    for (i = 0; i < sizeof(documents) / sizeof(documents[0]); i++)
+    {
+        check_document(documents[i], strlen(documents[i]));
+    }
+}
+
+static void generate(char *json, size_t *length, int depth)
+{
+    static const char *whitespace[] = { "", " ", "\n\t" };
+    unsigned long type = next_random() % ((depth > 4) ? 5 : 7);
+    unsigned long count = 0;
+    unsigned long i;
+
+    *length += (size_t)sprintf(json + *length, "%s", whitespace[next_random() % 3]);
+    switch (type)
+    {
+        case 0:
+            *length += (size_t)sprintf(json + *length, "null");
+            break;
+        case 1:
+            *length += (size_t)sprintf(json + *length, (next_random() % 2) ? "true" : "false");
+            break;
+        case 2:
+            *length += (size_t)sprintf(json + *length, "%ld.%lue%ld", (long)(next_random() % 2000) - 1000, next_random() % 100, (long)(next_random() % 20) - 10);
+            break;
+        case 3:
+            *length += (size_t)sprintf(json + *length, "\"k%lu\\u00e9\\n\"", next_random() % 100);
+            break;
+        case 4:
+            *length += (size_t)sprintf(json + *length, "\"plain%lu, with more text than a 16 byte block\"", next_random() % 100);
+            break;
+        case 5:
+            count = next_random() % 5;
+            json[(*length)++] = '[';
+            for (i = 0; i < count; i++)
+            {
+                if (i > 0)
+                {
+                    json[(*length)++] = ',';
+                }
+                generate(json, length, depth + 1);
+            }
+            json[(*length)++] = ']';
+            break;
+        default:
+            count = next_random() % 5;
+            json[(*length)++] = '{';
+            for (i = 0; i < count; i++)
+            {
+                if (i > 0)
+                {
+                    json[(*length)++] = ',';
+                }
+                *length += (size_t)sprintf(json + *length, "\"%s\":", (next_random() % 4) ? "b" : "a");
+                generate(json, length, depth + 1);
+            }
+            json[(*length)++] = '}';
+            break;
+    }
+    *length += (size_t)sprintf(json + *length, "%s", whitespace[next_random() % 3]);
+}
+
+/* the requested member comes last, so the damage is mostly in skipped values */
+static void test_random_documents(void)
+{
+    static const char damage[] = "{}[],:\"\\x1-.e ";
+    static char json[1 << 16];
+    int round;
+
+    for (round = 0; round < 50000; round++)
+    {
+        size_t length = 0;
+        json[length++] = '{';
+        length += (size_t)sprintf(json + length, "\"b\":");
+        generate(json, &length, 1);
+        length += (size_t)sprintf(json + length, ",\"a\":1}");
+        json[length] = '\0';
+
+        check_document(json, length);
+        json[1 + (next_random() % (length - 9))] = damage[next_random() % (sizeof(damage) - 1)];
+        check_document(json, length);
+    }
+}
+
+int main(void)
+{
+    test_skipped_errors();
+    test_random_documents();
+
+    return TEST_RESULT();
+}
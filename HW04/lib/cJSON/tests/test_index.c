@@ -0,0 +1,277 @@
+/*
+  Lookup indexes: size, item access and lookups in indexed arrays and objects have to find the same items
+  as the linear walk after every kind of change, access must never build an index itself, and trees whose
+  memory doesn't come from the global hooks must refuse one.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cJSON.h"
+#include "common.h"
+
+#define KEYS 500
+
+static void *CJSON_CDECL context_allocate(size_t size, void *userdata)
+{
+    (void)userdata;
+    return malloc(size);
+}
+
+static void CJSON_CDECL context_deallocate(void *pointer, void *userdata)
+{
+    (void)userdata;
+    free(pointer);
+}
+
+static void make_key(char *key, int number)
+{
+    sprintf(key, "key%d", number);
+}
+
+/* the reference answer: a walk over the children */
+static cJSON *linear_lookup(const cJSON *object, const char *key)
+{
+    cJSON *child = NULL;
+    for (child = object->child; (child != NULL) && (child->string != NULL); child = child->next)
+    {
+        if (strcmp(child->string, key) == 0)
+        {
+            return child;
+        }
+    }
+
+    return NULL;
+}
+
+static void check_lookups(const cJSON *object, int keys)
+{
+    char key[32];
+    int number;
+
+    for (number = -1; number <= keys; number++)
+    {
+        make_key(key, number);
+        TEST_CHECK_MESSAGE(cJSON_GetObjectItemCaseSensitive(object, key) == linear_lookup(object, key), key);
+    }
+}
+
+/* the reference answers come from the list itself */
+static void check_array(const cJSON *array)
+{
+    const cJSON *child = NULL;
+    int position = 0;
+
+    for (child = array->child; child != NULL; child = child->next)
+    {
+        TEST_CHECK(cJSON_GetArrayItem(array, position) == child);
+        position++;
+    }
+    TEST_CHECK(cJSON_GetArraySize(array) == position);
+    TEST_CHECK(cJSON_GetArrayItem(array, position) == NULL);
+    TEST_CHECK(cJSON_GetArrayItem(array, -1) == NULL);
+}
+
+static cJSON *create_object(int keys)
+{
+    cJSON *object = cJSON_CreateObject();
+    char key[32];
+    int number;
+
+    for (number = 0; number < keys; number++)
+    {
+        make_key(key, number);
+        cJSON_AddNumberToObject(object, key, number);
+    }
+
+    return object;
+}
+
+static void test_object_index(void)
+{
+    cJSON *object = create_object(KEYS);
+    char key[32];
+    int number;
+
+    /* lookups alone don't index */
+    check_lookups(object, KEYS);
+    TEST_CHECK(object->index == NULL);
+
+    TEST_CHECK(cJSON_IndexObject(object));
+    TEST_CHECK(object->index != NULL);
+    check_lookups(object, KEYS);
+
+    /* appending keeps the index and grows it */
+    for (number = KEYS; number < 4 * KEYS; number++)
+    {
+        make_key(key, number);
+        cJSON_AddNumberToObject(object, key, number);
+    }
+    TEST_CHECK(object->index != NULL);
+    check_lookups(object, 4 * KEYS);
+
+    /* duplicate keys: the first one is found */
+    cJSON_AddStringToObject(object, "key7", "duplicate");
+    TEST_CHECK(cJSON_IsNumber(cJSON_GetObjectItemCaseSensitive(object, "key7")));
+
+    /* detaching, replacing and inserting drop it */
+    cJSON_DeleteItemFromObjectCaseSensitive(object, "key3");
+    TEST_CHECK(object->index == NULL);
+    check_lookups(object, 4 * KEYS);
+    TEST_CHECK(cJSON_GetObjectItemCaseSensitive(object, "key3") == NULL);
+
+    TEST_CHECK(cJSON_IndexObject(object));
+    cJSON_ReplaceItemInObjectCaseSensitive(object, "key10", cJSON_CreateString("replaced"));
+    TEST_CHECK(object->index == NULL);
+    TEST_CHECK(cJSON_IsString(cJSON_GetObjectItemCaseSensitive(object, "key10")));
+
+    TEST_CHECK(cJSON_IndexObject(object));
+    cJSON_InsertItemInArray(object, 0, cJSON_CreateNull());
+    TEST_CHECK(object->index == NULL);
+
+    /* a child without key ends the lookup, indexed or not */
+    TEST_CHECK(cJSON_IndexObject(object));
+    check_lookups(object, 4 * KEYS);
+    TEST_CHECK(cJSON_GetObjectItemCaseSensitive(object, "key20") == NULL);
+
+    /* cJSON_InvalidateIndex after changing a key by hand */
+    cJSON_DeleteItemFromArray(object, 0);
+    TEST_CHECK(cJSON_IndexObject(object));
+    object->child->next->string[0] = 'K';
+    cJSON_InvalidateIndex(object);
+    TEST_CHECK(object->index == NULL);
+    check_lookups(object, 4 * KEYS);
+
+    cJSON_Delete(object);
+}
+
+static void test_array_index(void)
+{
+    cJSON *array = cJSON_CreateArray();
+    int number;
+
+    for (number = 0; number < KEYS; number++)
+    {
+        cJSON_AddItemToArray(array, cJSON_CreateNumber(number));
+    }
+
+    /* access alone doesn't index */
+    check_array(array);
+    TEST_CHECK(array->index == NULL);
+
+    TEST_CHECK(cJSON_IndexArray(array));
+    check_array(array);
+
+    /* appending keeps the vector and grows it */
+    for (number = KEYS; number < 4 * KEYS; number++)
+    {
+        cJSON_AddItemToArray(array, cJSON_CreateNumber(number));
+    }
+    TEST_CHECK(array->index != NULL);
+    check_array(array);
+
+    /* replacing by position keeps it, replacing via pointer drops it */
+    TEST_CHECK(cJSON_ReplaceItemInArray(array, 100, cJSON_CreateString("replaced")));
+    TEST_CHECK(array->index != NULL);
+    TEST_CHECK(cJSON_IsString(cJSON_GetArrayItem(array, 100)));
+    check_array(array);
+    TEST_CHECK(cJSON_ReplaceItemViaPointer(array, cJSON_GetArrayItem(array, 0), cJSON_CreateTrue()));
+    TEST_CHECK(array->index == NULL);
+    check_array(array);
+
+    /* detaching, deleting and inserting by position keep it, detaching via pointer drops it */
+    TEST_CHECK(cJSON_IndexArray(array));
+    cJSON_DeleteItemFromArray(array, 5);
+    TEST_CHECK(array->index != NULL);
+    check_array(array);
+    cJSON_Delete(cJSON_DetachItemFromArray(array, cJSON_GetArraySize(array) - 1));
+    TEST_CHECK(array->index != NULL);
+    check_array(array);
+
+    TEST_CHECK(cJSON_InsertItemInArray(array, 7, cJSON_CreateFalse()));
+    TEST_CHECK(array->index != NULL);
+    TEST_CHECK(cJSON_IsFalse(cJSON_GetArrayItem(array, 7)));
+    check_array(array);
+    TEST_CHECK(cJSON_InsertItemInArray(array, 0, cJSON_CreateFalse()));
+    TEST_CHECK(array->index != NULL);
+    check_array(array);
+
+    /* inserting into a full vector grows it */
+    for (number = 0; number < 4 * KEYS; number++)
+    {
+        TEST_CHECK(cJSON_InsertItemInArray(array, number % 50, cJSON_CreateNumber(number)));
+    }
+    TEST_CHECK(array->index != NULL);
+    check_array(array);
+
+    cJSON_Delete(cJSON_DetachItemViaPointer(array, cJSON_GetArrayItem(array, 3)));
+    TEST_CHECK(array->index == NULL);
+    check_array(array);
+
+    /* removing one by one from the front and the middle keeps it */
+    TEST_CHECK(cJSON_IndexArray(array));
+    for (number = 0; number < 2 * KEYS; number++)
+    {
+        cJSON_DeleteItemFromArray(array, ((number % 2) == 0) ? 0 : cJSON_GetArraySize(array) / 2);
+    }
+    TEST_CHECK(array->index != NULL);
+    check_array(array);
+
+    /* an empty array gets a vector, too */
+    while (array->child != NULL)
+    {
+        cJSON_DeleteItemFromArray(array, 0);
+    }
+    TEST_CHECK(cJSON_IndexArray(array));
+    check_array(array);
+    cJSON_AddItemToArray(array, cJSON_CreateNull());
+    check_array(array);
+
+    TEST_CHECK(!cJSON_IndexArray(cJSON_GetArrayItem(array, 0)));
+    cJSON_Delete(array);
+}
+
+static void test_refused(void)
+{
+    static const char json[] = "{\"a\": [1, 2], \"b\": {\"c\": 2}}";
+    cJSON *object = create_object(10);
+    cJSON *reference = cJSON_CreateObjectReference(object);
+    cJSON_Arena *arena = cJSON_CreateArena(0);
+    cJSON_Context context;
+    cJSON *parsed = NULL;
+
+    TEST_CHECK(!cJSON_IndexObject(NULL));
+    TEST_CHECK(!cJSON_IndexObject(reference));
+    TEST_CHECK(!cJSON_IndexObject(cJSON_GetObjectItem(object, "key1")));
+    cJSON_Delete(reference);
+    cJSON_Delete(object);
+
+    parsed = cJSON_ParseWithLengthArena(json, sizeof(json) - 1, arena);
+    TEST_CHECK(parsed != NULL);
+    TEST_CHECK(!cJSON_IndexObject(parsed));
+    TEST_CHECK(!cJSON_IndexObject(cJSON_GetObjectItem(parsed, "b")));
+    TEST_CHECK(!cJSON_IndexArray(cJSON_GetObjectItem(parsed, "a")));
+    cJSON_DeleteArena(arena);
+
+    memset(&context, 0, sizeof(context));
+    parsed = cJSON_ParseWithContext(json, sizeof(json) - 1, &context);
+    TEST_CHECK(cJSON_IndexObject(parsed));
+    cJSON_DeleteWithContext(parsed, &context);
+
+    context.allocate = context_allocate;
+    context.deallocate = context_deallocate;
+    parsed = cJSON_ParseWithContext(json, sizeof(json) - 1, &context);
+    TEST_CHECK(parsed != NULL);
+    TEST_CHECK(!cJSON_IndexObject(parsed));
+    TEST_CHECK(!cJSON_IndexArray(cJSON_GetObjectItem(parsed, "a")));
+    cJSON_DeleteWithContext(parsed, &context);
+}
+
+int main(void)
+{
+    test_object_index();
+    test_array_index();
+    test_refused();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,140 @@
+/*
+  Number parsing: the fast paths of parse_number (exact powers of ten, Eisel-Lemire) have to give
+  bit for bit the same double as strtod, including subnormals, the 2^53 boundary, long mantissas
+  and overflow / underflow.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../cJSON.h"
+#include "common.h"
+
+static unsigned long random_state = 12345;
+
+static unsigned long next_random(void)
+{
+    random_state = random_state * 1103515245UL + 12345UL;
+    return (random_state >> 16) & 0x7fff;
+}
+
+static void check_number(const char *text)
+{
+    double expected = strtod(text, NULL);
+    cJSON *number = cJSON_Parse(text);
+
+    TEST_CHECK_MESSAGE(cJSON_IsNumber(number), text);
+    if (number != NULL)
+    {
+        TEST_CHECK_MESSAGE(memcmp(&number->valuedouble, &expected, sizeof(double)) == 0, text);
+    }
+    cJSON_Delete(number);
+}
+
+static void test_known_numbers(void)
+{
+    static const char *numbers[] =
+    {
+        /* small integers and exact fractions */
+        "0", "-0", "1", "-1", "0.5", "0.1", "0.2", "0.3", "123.456", "-2.5e-3", "1e0", "1E+2", "1e-0",
+        /* the 2^53 boundary, 2^53 + 1 is not representable */
+        "9007199254740991", "9007199254740992", "9007199254740993", "9007199254740994", "9007199254740995",
+        "-9007199254740993", "9007199254740993e0", "9007199254740993.0", "900719925474099.3e1",
+        /* 19 and 20 digit mantissas */
+        "1234567890123456789", "9999999999999999999", "18446744073709551615", "18446744073709551616",
+        "12345678901234567890", "99999999999999999999", "0.12345678901234567890", "1.0000000000000000001",
+        "9223372036854775807", "9223372036854775808", "-9223372036854775809",
+        "2.2250738585072011e-308", "2.2250738585072012e-308", "7.2057594037927933e16",
+        "1.7976931348623157e308", "1.7976931348623158e308", "4.9406564584124654e-324",
+        /* halfway cases */
+        "9007199254740993.000000000000000000000000000000000000000000001",
+        "1.00000000000000011102230246251565404236316680908203125",
+        "1.00000000000000011102230246251565404236316680908203124",
+        "1.00000000000000011102230246251565404236316680908203126",
+        /* subnormals */
+        "5e-324", "4.9e-324", "2.5e-324", "2.4703282292062328e-324", "1e-310", "2.225073858507201e-308",
+        "1e-320", "-1e-315", "3e-323", "1.23456789e-315",
+        /* overflow to inf and underflow to 0 */
+        "1e309", "-1e309", "1.8e308", "1e400", "1e-400", "-1e-400", "2e-324", "1e-330",
+        "123456789012345678901234567890e300", "0.000000000000000000001e-320",
+        /* exponents at the edges of the power table */
+        "1e22", "1e23", "1e-22", "1e-23", "1e64", "1e-64", "1e65", "1e-65", "123e-70", "4.5e80", "8.7e-100",
+        "1e308", "1e-308", "1e-307"
+    };
+    size_t i;
+
+    for (i = 0; i < sizeof(numbers) / sizeof(numbers[0]); i++)
+    {
+        check_number(numbers[i]);
+    }
+}
+
+/* random mantissas of 1 to 24 digits with random decimal point and exponent */
+static void test_random_decimals(void)
+{
+    char text[64];
+    int round;
+
+    for (round = 0; round < 200000; round++)
+    {
+        int digits = 1 + (int)(next_random() % 24);
+        int point = (int)(next_random() % (unsigned long)(digits + 1));
+        int exponent = (int)(next_random() % 700) - 350;
+        size_t length = 0;
+        int i;
+
+        if (next_random() & 1)
+        {
+            text[length++] = '-';
+        }
+        for (i = 0; i < digits; i++)
+        {
+            if ((i == point) && (i > 0))
+            {
+                text[length++] = '.';
+            }
+            text[length++] = (char)('0' + ((i == 0) ? 1 + next_random() % 9 : next_random() % 10));
+        }
+        sprintf(text + length, "e%d", exponent);
+        check_number(text);
+    }
+}
+
+/* random doubles written with 17 significant digits must come back exactly */
+static void test_random_doubles(void)
+{
+    char text[64];
+    int round;
+
+    for (round = 0; round < 200000; round++)
+    {
+        unsigned char bytes[sizeof(double)];
+        double value;
+        size_t i;
+
+        for (i = 0; i < sizeof(bytes); i++)
+        {
+            bytes[i] = (unsigned char)next_random();
+        }
+        memcpy(&value, bytes, sizeof(value));
+        if ((value != value) || (value > 1.7976931348623157e308) || (value < -1.7976931348623157e308))
+        {
+            continue;
+        }
+
+        sprintf(text, "%.17g", value);
+        check_number(text);
+        sprintf(text, "%.15g", value);
+        check_number(text);
+    }
+}
+
+int main(void)
+{
+    test_known_numbers();
+    test_random_decimals();
+    test_random_doubles();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,162 @@
+/*
+  Number printing: every printed number has to read back with strtod as the same double, with the
+  fewest significant digits that do so, and normal numbers of up to 15 digits have to look like "%1.15g".
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../cJSON.h"
+#include "common.h"
+
+static unsigned long random_state = 54321;
+
+static unsigned long next_random(void)
+{
+    random_state = random_state * 1103515245UL + 12345UL;
+    return (random_state >> 16) & 0x7fff;
+}
+
+static int significant_digits(const char *text)
+{
+    int digits = 0;
+    int zeros = 0;
+    cJSON_bool leading = 1;
+
+    for (; (*text != '\0') && (*text != 'e'); text++)
+    {
+        if ((*text < '0') || (*text > '9'))
+        {
+            continue;
+        }
+        if (*text == '0')
+        {
+            if (!leading)
+            {
+                zeros++;
+            }
+            continue;
+        }
+        leading = 0;
+        digits += zeros + 1;
+        zeros = 0;
+    }
+
+    return digits;
+}
+
+static int shortest_digits(double value)
+{
+    char text[64];
+    int precision;
+
+    for (precision = 1; precision < 17; precision++)
+    {
+        sprintf(text, "%.*e", precision - 1, value);
+        if (strtod(text, NULL) == value)
+        {
+            break;
+        }
+    }
+
+    return precision;
+}
+
+static void check_print(double value)
+{
+    cJSON *number = cJSON_CreateNumber(value);
+    char *printed = cJSON_PrintUnformatted(number);
+    char message[128];
+    double back;
+
+    TEST_CHECK(printed != NULL);
+    if (printed == NULL)
+    {
+        cJSON_Delete(number);
+        return;
+    }
+    sprintf(message, "%.17g printed as %s", value, printed);
+
+    back = strtod(printed, NULL);
+    TEST_CHECK_MESSAGE(memcmp(&back, &value, sizeof(value)) == 0, message);
+    TEST_CHECK_MESSAGE((value == 0) || (significant_digits(printed) == shortest_digits(value)), message);
+    /* subnormals have fewer digits of precision than "%1.15g" prints */
+    if ((fabs(value) >= 2.2250738585072014e-308) && (significant_digits(printed) <= 15))
+    {
+        char expected[64];
+        sprintf(expected, "%1.15g", value);
+        TEST_CHECK_MESSAGE(strcmp(printed, expected) == 0, message);
+    }
+
+    cJSON_free(printed);
+    cJSON_Delete(number);
+}
+
+static void test_known_numbers(void)
+{
+    static const double numbers[] =
+    {
+        0.0, 1.0, -1.0, 0.1, 0.2, 0.3, 1.0 / 3.0, 2.0 / 3.0, 123.456, -2.5e-3, 1e15, 1e16, 1e17, 1e21, 1e22, 1e23,
+        9007199254740991.0, 9007199254740992.0, 9007199254740994.0, 999999999999999.0, 1e-5, 1e-4, 0.001,
+        1.7976931348623157e308, 2.2250738585072014e-308, 2.2250738585072009e-308, 4.9406564584124654e-324,
+        5e-324, 1e-310, 5.5, 12345678.9, 3.14159265358979, 2.718281828459045, 1.5e300, -1.5e-300,
+        /* Grisu2 returns 17 digits although 16 digits read back as the same double */
+        2.718316374298659e+276, -5.629506787100974e+163, -3.016985025548487e-224, -6.759707160883957e-162,
+        4.428205294422622e-269, -1.355577664812515e+274, 7.029786188581343e+93, 3.001278807721363e+97,
+        /* the same, but only the rounding down of a trailing 5 reads back */
+        -7.859483374861988e-56, 7.309061867032145e-168, -6.526809572713243e-103, -4.792115767729327e-143,
+        8.018822714932077e+99, 6.756884763296067e-47, 8.482088248780041e+37, 5.639607219426416e-252
+    };
+    size_t i;
+
+    for (i = 0; i < sizeof(numbers) / sizeof(numbers[0]); i++)
+    {
+        check_print(numbers[i]);
+    }
+}
+
+static void test_random_doubles(void)
+{
+    int round;
+
+    for (round = 0; round < 100000; round++)
+    {
+        unsigned char bytes[sizeof(double)];
+        double value;
+        size_t i;
+
+        for (i = 0; i < sizeof(bytes); i++)
+        {
+            bytes[i] = (unsigned char)next_random();
+        }
+        memcpy(&value, bytes, sizeof(value));
+        if ((value != value) || (value > 1.7976931348623157e308) || (value < -1.7976931348623157e308))
+        {
+            continue;
+        }
+        check_print(value);
+    }
+}
+
+/* values as they come from measurements: few digits after the decimal point */
+static void test_random_decimals(void)
+{
+    int round;
+
+    for (round = 0; round < 100000; round++)
+    {
+        double value = (double)(long)(next_random() * 32768 + next_random()) / (double)(1 + next_random() % 10000);
+        check_print(value);
+        check_print(-value / 1000.0);
+    }
+}
+
+int main(void)
+{
+    test_known_numbers();
+    test_random_doubles();
+    test_random_decimals();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,177 @@
+/*
+  String scanning: quotes and escapes at every position relative to the 16 byte blocks of the SSE2
+  scanner have to decode the same way, truncated strings and malformed escapes have to fail at the
+  same error offset as the scalar scanner. The same program is built once more against a library
+  compiled with CJSON_NO_SIMD (test strings_scalar).
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cJSON.h"
+#include "common.h"
+
+#define MAX_LENGTH 80
+#define MAX_SHIFT 16
+
+/* "[" + shift spaces + quoted string of length characters with escape at position, returns the json length */
+static size_t build_document(char *json, size_t shift, size_t length, size_t position, const char *escape, char *expected)
+{
+    size_t json_length = 0;
+    size_t expected_length = 0;
+    size_t i;
+
+    json[json_length++] = '[';
+    for (i = 0; i < shift; i++)
+    {
+        json[json_length++] = ' ';
+    }
+    json[json_length++] = '\"';
+    for (i = 0; i < length; i++)
+    {
+        if ((i == position) && (escape != NULL))
+        {
+            memcpy(json + json_length, escape, strlen(escape));
+            json_length += strlen(escape);
+            expected[expected_length++] = (escape[1] == 'n') ? '\n' : escape[1];
+        }
+        else
+        {
+            json[json_length++] = (char)('a' + (i % 26));
+            expected[expected_length++] = (char)('a' + (i % 26));
+        }
+    }
+    json[json_length++] = '\"';
+    json[json_length++] = ']';
+    json[json_length] = '\0';
+    expected[expected_length] = '\0';
+
+    return json_length;
+}
+
+static void test_escape_positions(void)
+{
+    static const char *escapes[] = { NULL, "\\\"", "\\\\", "\\n", "\\/" };
+    char json[MAX_SHIFT + MAX_LENGTH + 8];
+    char expected[MAX_LENGTH + 1];
+    size_t shift;
+    size_t length;
+    size_t position;
+    size_t escape;
+
+    for (escape = 0; escape < sizeof(escapes) / sizeof(escapes[0]); escape++)
+    {
+        for (shift = 0; shift < MAX_SHIFT; shift++)
+        {
+            for (length = 0; length < MAX_LENGTH; length++)
+            {
+                for (position = 0; position < ((length > 0) ? length : 1); position++)
+                {
+                    size_t json_length = build_document(json, shift, length, position, escapes[escape], expected);
+                    cJSON *array = cJSON_ParseWithLength(json, json_length);
+                    cJSON *string = cJSON_GetArrayItem(array, 0);
+
+                    TEST_CHECK_MESSAGE(cJSON_IsString(string), json);
+                    TEST_CHECK_MESSAGE((string != NULL) && (strcmp(string->valuestring, expected) == 0), json);
+                    cJSON_Delete(array);
+
+                    /* a cut right behind the opening quote fails at the quote, every later cut inside the string behind it */
+                    if ((shift == 0) || (shift == 7))
+                    {
+                        size_t cut;
+                        TEST_CHECK_MESSAGE(cJSON_ParseWithLength(json, shift + 2) == NULL, json);
+                        TEST_CHECK_MESSAGE(cJSON_GetErrorPtr() == json + shift + 1, json);
+                        for (cut = shift + 3; cut < json_length - 1; cut++)
+                        {
+                            TEST_CHECK_MESSAGE(cJSON_ParseWithLength(json, cut) == NULL, json);
+                            TEST_CHECK_MESSAGE(cJSON_GetErrorPtr() == json + shift + 2, json);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void test_malformed_escapes(void)
+{
+    static const struct
+    {
+        const char *json;
+        size_t error_offset;
+    } cases[] =
+    {
+        { "\"abc", 1 },
+        { "[\"abcdefghijklmnopqrstuvwxyz", 2 },
+        { "[\"ab\\", 2 },
+        { "{\"a\":\"x\\u12\"}", 7 },
+        { "\"ab\\q\"", 3 },
+        { "\"\\ud800\"", 1 },
+        { "\"\\ud800\\u0041\"", 1 },
+        { "\"\\udc00\"", 1 },
+        { "[\"0123456789abcdef0123456789\\x\"]", 28 }
+    };
+    size_t i;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        TEST_CHECK_MESSAGE(cJSON_ParseWithLength(cases[i].json, strlen(cases[i].json)) == NULL, cases[i].json);
+        TEST_CHECK_MESSAGE(cJSON_GetErrorPtr() == cases[i].json + cases[i].error_offset, cases[i].json);
+    }
+}
+
+static void test_unicode_escapes(void)
+{
+    static const struct
+    {
+        const char *json;
+        const char *expected;
+    } cases[] =
+    {
+        { "\"\\u0041\"", "A" },
+        { "\"\\u00e9\"", "\xc3\xa9" },
+        { "\"\\u20AC\"", "\xe2\x82\xac" },
+        { "\"\\ud83d\\ude00\"", "\xf0\x9f\x98\x80" },
+        { "\"0123456789abcdef\\u0041 0123456789abcdef\"", "0123456789abcdefA 0123456789abcdef" },
+        { "\"\\b\\f\\n\\r\\t\"", "\b\f\n\r\t" }
+    };
+    size_t i;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        cJSON *string = cJSON_ParseWithLength(cases[i].json, strlen(cases[i].json));
+        TEST_CHECK_MESSAGE((string != NULL) && (strcmp(string->valuestring, cases[i].expected) == 0), cases[i].json);
+        cJSON_Delete(string);
+    }
+}
+
+/* keys go through the same scanner as values */
+static void test_long_keys(void)
+{
+    char json[2 * MAX_LENGTH + 16];
+    char key[MAX_LENGTH + 1];
+    size_t length;
+
+    for (length = 1; length < MAX_LENGTH; length++)
+    {
+        cJSON *object;
+        memset(key, 'k', length);
+        key[length] = '\0';
+        sprintf(json, "{\"%s\":\"%s\"}", key, key);
+
+        object = cJSON_Parse(json);
+        TEST_CHECK_MESSAGE(object != NULL, json);
+        TEST_CHECK_MESSAGE(strcmp(cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(object, key)), key) == 0, json);
+        cJSON_Delete(object);
+    }
+}
+
+int main(void)
+{
+    test_escape_positions();
+    test_malformed_escapes();
+    test_unicode_escapes();
+    test_long_keys();
+
+    return TEST_RESULT();
+}
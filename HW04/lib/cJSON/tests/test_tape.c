@@ -0,0 +1,262 @@
+/*
+  Tape parsing: for random documents, valid or damaged, cJSON_ParseTape has to accept exactly what
+  cJSON_Parse accepts, fail at the same error position, and the tree rebuilt through the iterator API
+  has to print like the tree of cJSON_Parse.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cJSON.h"
+#include "common.h"
+
+static unsigned long random_state = 1;
+
+static unsigned long next_random(void)
+{
+    random_state = random_state * 1103515245UL + 12345UL;
+    return (random_state >> 8) & 0xffffff;
+}
+
+/* keys are raw text on the tape, decode them like the parser does */
+static cJSON *decode_key(const char *key, size_t length)
+{
+    char quoted[256];
+
+    quoted[0] = '\"';
+    memcpy(quoted + 1, key, length);
+    quoted[length + 1] = '\"';
+
+    return cJSON_ParseWithLength(quoted, length + 2);
+}
+
+static cJSON *build_tree(cJSON_TapeIterator value)
+{
+    cJSON_TapeIterator child;
+    cJSON *item = NULL;
+    char string[256];
+    int count = 0;
+
+    switch (cJSON_TapeType(value))
+    {
+        case cJSON_NULL:
+            return cJSON_CreateNull();
+        case cJSON_True:
+            return cJSON_CreateTrue();
+        case cJSON_False:
+            return cJSON_CreateFalse();
+        case cJSON_Number:
+            return cJSON_CreateNumber(cJSON_TapeGetNumber(value));
+        case cJSON_String:
+            TEST_CHECK(cJSON_TapeGetString(value, string, sizeof(string)) < sizeof(string));
+            return cJSON_CreateString(string);
+        case cJSON_Array:
+            item = cJSON_CreateArray();
+            cJSON_TapeForEach(child, value)
+            {
+                TEST_CHECK(cJSON_TapeGetArrayItem(value, count).position == child.position);
+                cJSON_AddItemToArray(item, build_tree(child));
+                count++;
+            }
+            TEST_CHECK(cJSON_TapeGetSize(value) == count);
+            TEST_CHECK(!cJSON_TapeIsValid(cJSON_TapeGetArrayItem(value, count)));
+            return item;
+        case cJSON_Object:
+            item = cJSON_CreateObject();
+            cJSON_TapeForEach(child, value)
+            {
+                size_t length = 0;
+                const char *key = cJSON_TapeGetKey(child, &length);
+                cJSON *decoded = decode_key(key, length);
+                char raw_key[256];
+
+                /* lookups compare the raw key text, the first duplicate wins */
+                memcpy(raw_key, key, length);
+                raw_key[length] = '\0';
+                TEST_CHECK(cJSON_TapeIsValid(cJSON_TapeGetObjectItem(value, raw_key)));
+
+                TEST_CHECK(decoded != NULL);
+                if (decoded != NULL)
+                {
+                    cJSON_AddItemToObject(item, decoded->valuestring, build_tree(child));
+                }
+                cJSON_Delete(decoded);
+                count++;
+            }
+            TEST_CHECK(cJSON_TapeGetSize(value) == count);
+            return item;
+        default:
+            TEST_CHECK(0);
+            return cJSON_CreateNull();
+    }
+}
+
+static void generate(char *json, size_t *length, int depth)
+{
+    static const char *whitespace[] = { "", " ", "\n\t" };
+    unsigned long type = next_random() % ((depth > 4) ? 5 : 7);
+    unsigned long count = 0;
+    unsigned long i;
+
+    *length += (size_t)sprintf(json + *length, "%s", whitespace[next_random() % 3]);
+    switch (type)
+    {
+        case 0:
+            *length += (size_t)sprintf(json + *length, "null");
+            break;
+        case 1:
+            *length += (size_t)sprintf(json + *length, (next_random() % 2) ? "true" : "false");
+            break;
+        case 2:
+            *length += (size_t)sprintf(json + *length, "%ld.%lue%ld", (long)(next_random() % 2000) - 1000, next_random() % 100, (long)(next_random() % 20) - 10);
+            break;
+        case 3:
+            *length += (size_t)sprintf(json + *length, "\"k%lu\\u00e9\\n\"", next_random() % 100);
+            break;
+        case 4:
+            *length += (size_t)sprintf(json + *length, "\"plain%lu, with more text than a 16 byte block\"", next_random() % 100);
+            break;
+        case 5:
+            count = next_random() % 5;
+            json[(*length)++] = '[';
+            for (i = 0; i < count; i++)
+            {
+                if (i > 0)
+                {
+                    json[(*length)++] = ',';
+                }
+                generate(json, length, depth + 1);
+            }
+            json[(*length)++] = ']';
+            break;
+        default:
+            count = next_random() % 5;
+            json[(*length)++] = '{';
+            for (i = 0; i < count; i++)
+            {
+                if (i > 0)
+                {
+                    json[(*length)++] = ',';
+                }
+                *length += (size_t)sprintf(json + *length, "\"m%lu%s\":", i, (next_random() % 4) ? "" : "\\t");
+                generate(json, length, depth + 1);
+            }
+            json[(*length)++] = '}';
+            break;
+    }
+    *length += (size_t)sprintf(json + *length, "%s", whitespace[next_random() % 3]);
+}
+
+static void check_document(const char *json, size_t length)
+{
+    cJSON *tree = cJSON_ParseWithLength(json, length);
+    const char *tree_error = cJSON_GetErrorPtr();
+    cJSON_Tape *tape = cJSON_ParseTape(json, length);
+    const char *tape_error = cJSON_GetErrorPtr();
+
+    TEST_CHECK_MESSAGE((tree == NULL) == (tape == NULL), json);
+    if ((tree == NULL) && (tape == NULL))
+    {
+        TEST_CHECK_MESSAGE(tree_error == tape_error, json);
+    }
+    if ((tree != NULL) && (tape != NULL))
+    {
+        cJSON *rebuilt = build_tree(cJSON_TapeRoot(tape));
+        char *tree_text = cJSON_PrintUnformatted(tree);
+        char *tape_text = cJSON_PrintUnformatted(rebuilt);
+
+        TEST_CHECK_MESSAGE(strcmp(tree_text, tape_text) == 0, json);
+        cJSON_free(tree_text);
+        cJSON_free(tape_text);
+        cJSON_Delete(rebuilt);
+    }
+
+    cJSON_Delete(tree);
+    cJSON_DeleteTape(tape);
+}
+
+static void test_random_documents(void)
+{
+    static const char damage[] = "{}[],:\"\\x1 ";
+    static char json[1 << 16];
+    int round;
+
+    for (round = 0; round < 50000; round++)
+    {
+        size_t length = 0;
+        generate(json, &length, 0);
+        json[length] = '\0';
+
+        check_document(json, length);
+        json[next_random() % length] = damage[next_random() % (sizeof(damage) - 1)];
+        check_document(json, length);
+        /* cut short */
+        check_document(json, 1 + (next_random() % length));
+    }
+}
+
+static void test_errors(void)
+{
+    static const char *documents[] =
+    {
+        "\"abc", "{\"abc", "{\"a\":1,\"b", "[\"ab\\", "{\"a\":\"x\\u12\"}", "\"\\ud800\"", "[1,]", "{\"a\" 1}",
+        "[tru]", "[1 2]", "-", "{\"a\":{\"b\":[}}", "   ", "\xEF\xBB\xBF"
+    };
+    size_t i;
+
+    for (i = 0; i < sizeof(documents) / sizeof(documents[0]); i++)
+    {
+        check_document(documents[i], strlen(documents[i]));
+    }
+}
+
+static void test_iterators(void)
+{
+    static const char json[] = "{\"title\": \"Mos\\\"cow\", \"days\": [1.5, 2, -3e2], \"empty\": {}, \"title\": \"duplicate\"}";
+    cJSON_Tape *tape = cJSON_ParseTape(json, sizeof(json) - 1);
+    cJSON_TapeIterator root = cJSON_TapeRoot(tape);
+    cJSON_TapeIterator days = cJSON_TapeGetObjectItem(root, "days");
+    cJSON_TapeIterator title = cJSON_TapeGetObjectItem(root, "title");
+    char buffer[8];
+    size_t length = 0;
+    const char *raw = NULL;
+
+    TEST_CHECK(tape != NULL);
+    TEST_CHECK(cJSON_TapeType(root) == cJSON_Object);
+    TEST_CHECK(cJSON_TapeGetSize(root) == 4);
+
+    /* strings decode like snprintf */
+    TEST_CHECK(cJSON_TapeGetString(title, buffer, sizeof(buffer)) == 7);
+    TEST_CHECK(strcmp(buffer, "Mos\"cow") == 0);
+    TEST_CHECK(cJSON_TapeGetString(title, buffer, 4) == 7);
+    TEST_CHECK(strcmp(buffer, "Mos") == 0);
+    raw = cJSON_TapeGetRaw(title, &length);
+    TEST_CHECK((length == 8) && (strncmp(raw, "Mos\\\"cow", length) == 0));
+
+    TEST_CHECK(cJSON_TapeGetSize(days) == 3);
+    TEST_CHECK(cJSON_TapeGetNumber(cJSON_TapeGetArrayItem(days, 0)) == 1.5);
+    TEST_CHECK(cJSON_TapeGetNumber(cJSON_TapeGetArrayItem(days, 2)) == -300);
+    TEST_CHECK(!cJSON_TapeIsValid(cJSON_TapeGetArrayItem(days, 3)));
+    TEST_CHECK(!cJSON_TapeIsValid(cJSON_TapeGetArrayItem(days, -1)));
+    TEST_CHECK(cJSON_TapeGetNumber(days) != cJSON_TapeGetNumber(days)); /* NAN */
+    TEST_CHECK(cJSON_TapeGetString(days, buffer, sizeof(buffer)) == 0);
+
+    /* the next sibling of an array skips all of its children */
+    TEST_CHECK(cJSON_TapeType(cJSON_TapeNext(days)) == cJSON_Object);
+    TEST_CHECK(cJSON_TapeGetSize(cJSON_TapeNext(days)) == 0);
+    TEST_CHECK(!cJSON_TapeIsValid(cJSON_TapeChild(cJSON_TapeNext(days))));
+    TEST_CHECK(!cJSON_TapeIsValid(cJSON_TapeNext(cJSON_TapeNext(cJSON_TapeNext(days)))));
+    TEST_CHECK(!cJSON_TapeIsValid(cJSON_TapeGetObjectItem(root, "missing")));
+    TEST_CHECK(cJSON_TapeType(cJSON_TapeGetObjectItem(root, "missing")) == cJSON_Invalid);
+
+    cJSON_DeleteTape(tape);
+}
+
+int main(void)
+{
+    test_errors();
+    test_iterators();
+    test_random_documents();
+
+    return TEST_RESULT();
+}
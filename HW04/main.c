@@ -1,3 +1,5 @@
+#define _POSIX_C_SOURCE 200809L
+
 /**
  * Сборка проекта происходит в файле make.sh
  * Библтотека cJSON собрана статически (lib/cJSON/libcJSON.a)
@@ -5,207 +7,860 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
+#include <time.h>
 #include <glib.h>
-#include <curl/curl.h>
 #include "lib/cJSON/cJSON.h"
+#include "http.h"
+#include "woeid_cache.h"
+#include "response_cache.h"
+#include "json_stream.h"
+#include "history.h"
+#include "output.h"
+#include "weatherd.h"
 
 #define API_URL "https://www.metaweather.com/api"
+#define API_URL_ENV "HW04_API_URL" // переменная окружения с адресом api вместо API_URL
 #define API_URN_SEARCH "/location/search/?query="
-#define API_URN_LOCATION "/api/location/"
-#define MAX_BUF 65536
+#define API_URN_LOCATION "/location/"
+#define DEFAULT_PARALLEL 16
+#define WOEID_CACHE_ENV "HW04_WOEID_CACHE"
+#define WOEID_CACHE_FILE ".hw04_woeid.cache"
+#define RESPONSE_CACHE_ENV "HW04_CACHE_DIR"
+#define RESPONSE_CACHE_DIR ".hw04_cache"
+#define RESPONSE_CACHE_TTL_ENV "HW04_CACHE_TTL"
+#define RESPONSE_CACHE_TTL 600
+#define HISTORY_DIR "history" // каталог архива погоды по умолчанию
+#define DAEMON_INTERVAL 600 // период обновления данных демоном по умолчанию, с
 
-char wr_buf[MAX_BUF + 1]; // буфер полученных данных
-int wr_index;
+#define METEO_DATE_MAX 16
+#define METEO_DESCRIPTION_MAX 48
+#define METEO_RESERVE 8 // обычное кол-во дней прогноза с запасом
+#define METEO_BINARY_MAGIC "HW04MET1"
+#define FIXED_POINT_SCALE 100 // числа с фиксированной точкой в машинном выводе - сотые доли
+#define EPOCH_DAY_NONE INT32_MIN // дату записи не удалось разобрать
 
 /**
- * Структура описания температуры в локации
+ * Структура описания температуры в локации. Строки хранятся в самой структуре,
+ * поэтому она выделяется и освобождается одним блоком
  */
 typedef struct {
-    char *applicable_date; // время создания записи о погоде
-    char *weather_description; // описание погоды
-    char *wind_speed; // скорость ветра
-    char *wind_direction; // направление ветра
-    char *min_temp; // минимальная температура
-    char *max_temp; // максимальная температура
+    char applicable_date[METEO_DATE_MAX]; // время создания записи о погоде
+    char weather_description[METEO_DESCRIPTION_MAX]; // описание погоды
+    double wind_speed; // скорость ветра
+    double wind_direction; // направление ветра
+    double min_temp; // минимальная температура
+    double max_temp; // максимальная температура
 } meteo;
 
+/**
+ * Вывод ошибки разбора json
+ */
+void print_json_error(void) {
+    const char *error_ptr = cJSON_GetErrorPtr();
+    if (error_ptr != NULL) {
+        fprintf(stderr, "Error before: %s\n", error_ptr);
+    }
+}
+
+/**
+ * Получаем woeid первой найденной локации, разбор останавливается на нем
+ */
+cJSON_bool woeid_field(int path_index, int element, const cJSON *value, void *userdata) {
+    (void) path_index;
+    (void) element;
+    if (!cJSON_IsNumber(value)) {
+        return 1;
+    }
+    *(int *) userdata = value->valueint;
+
+    return 0;
+}
+
 /**
  * парсим/получаем woeid из json строки
  * @param json - строка json которую разбираем
  * @return 0|<int> - 0 не удалось определить woeid | woeid
  */
 int woeid_from_json(const char *const json) {
-    cJSON *parsed_json = cJSON_Parse(json);
-    if (parsed_json == NULL) {
-        const char *error_ptr = cJSON_GetErrorPtr();
-        if (error_ptr != NULL) {
-            fprintf(stderr, "Error before: %s\n", error_ptr);
-        }
+    static const char *const paths[] = {"[*].woeid"};
+    int woeid = 0;
+
+    if (!cJSON_ExtractPaths(json, strlen(json) + 1, paths, 1, woeid_field, &woeid)) {
+        print_json_error();
         return 0;
     }
 
-    const cJSON *citys = NULL;
-    cJSON_ArrayForEach (citys, parsed_json) {
-        cJSON *woeid = cJSON_GetObjectItemCaseSensitive(citys, "woeid");
-        if (cJSON_IsNumber(woeid)) {
-            return woeid->valueint;
-        }
+    return woeid;
+}
+
+/**
+ * Поля элемента consolidated_weather, из которых заполняется meteo
+ */
+#define WEATHER_ITEM "consolidated_weather[*]."
+static const char *const meteo_item_paths[] = {
+    "weather_state_name", "applicable_date", "wind_speed", "wind_direction", "min_temp", "max_temp"
+};
+static const char *const meteo_weather_paths[] = {
+    WEATHER_ITEM "weather_state_name", WEATHER_ITEM "applicable_date", WEATHER_ITEM "wind_speed",
+    WEATHER_ITEM "wind_direction", WEATHER_ITEM "min_temp", WEATHER_ITEM "max_temp"
+};
+
+/**
+ * Расположение поля в meteo: size - размер строки, 0 - поле типа double
+ */
+static const struct {
+    size_t offset;
+    size_t size;
+} meteo_fields[] = {
+    {offsetof(meteo, weather_description), METEO_DESCRIPTION_MAX},
+    {offsetof(meteo, applicable_date), METEO_DATE_MAX},
+    {offsetof(meteo, wind_speed), 0},
+    {offsetof(meteo, wind_direction), 0},
+    {offsetof(meteo, min_temp), 0},
+    {offsetof(meteo, max_temp), 0}
+};
+#define METEO_FIELDS (int) (sizeof(meteo_fields) / sizeof(meteo_fields[0]))
+
+/**
+ * Состояние заполнения meteo при выборочном разборе json
+ */
+typedef struct {
+    GArray *weather; // массив заполняемых meteo
+    int started; // 1 - в массив уже добавлена meteo текущего разбора
+    int element; // индекс элемента consolidated_weather последней meteo
+} meteo_extract;
+
+/**
+ * Заполнение поля meteo значением из json. Значения нового элемента consolidated_weather
+ * добавляют в массив новую структуру meteo
+ */
+cJSON_bool meteo_field(int path_index, int element, const cJSON *value, void *userdata) {
+    meteo_extract *me = userdata;
+    if (!me->started || element != me->element) {
+        g_array_set_size(me->weather, me->weather->len + 1); // новая meteo заполнена нулями
+        me->started = 1;
+        me->element = element;
+    }
+
+    meteo *current = &g_array_index(me->weather, meteo, me->weather->len - 1);
+    char *field = (char *) current + meteo_fields[path_index].offset;
+    if (meteo_fields[path_index].size && cJSON_IsString(value) && value->valuestring != NULL) {
+        snprintf(field, meteo_fields[path_index].size, "%s", value->valuestring);
+    } else if (!meteo_fields[path_index].size && cJSON_IsNumber(value)) {
+        memcpy(field, &value->valuedouble, sizeof(double));
     }
 
-    cJSON_Delete(parsed_json);
+    return 1;
+}
+
+/**
+ * Массив meteo с памятью, заранее выделенной под обычное кол-во дней прогноза.
+ * При большем кол-ве записей массив растет геометрически
+ */
+GArray *meteo_array_new(void) {
+    return g_array_sized_new(FALSE, TRUE, sizeof(meteo), METEO_RESERVE);
+}
+
+/**
+ * Заполняем структуру meteo из json одного элемента consolidated_weather и добавляем ее в массив
+ * @param json - json элемента consolidated_weather
+ * @param len - размер json
+ * @param weather - массив meteo
+ * @return 0|1 - 0 элемент добавлен | 1 json не удалось разобрать
+ */
+int meteo_from_json(const char *json, size_t len, GArray *weather) {
+    meteo_extract me = {weather, 0, -1};
+    guint count = weather->len;
+
+    if (!cJSON_ExtractPaths(json, len, meteo_item_paths, METEO_FIELDS, meteo_field, &me)) {
+        print_json_error();
+        g_array_set_size(weather, count);
+        return 1;
+    }
 
     return 0;
 }
 
 /**
- * Получаем все данные по погоде в выбраной локации
+ * Получаем все данные по погоде в выбраной локации.
+ * Из json выбираются только нужные поля элементов consolidated_weather, остальное пропускается без разбора в дерево
  * @param json - строка json из которой получаем даныне
- * @return GSList* meteo - однонапрвленный список с заполненной структурой meteo (данные по погоде)
+ * @return GArray* meteo - массив структур meteo (данные по погоде), освобождается g_array_free
  */
-GSList* weather_from_json(const char *const json) {
-    GSList *list_weather = NULL;
+GArray *weather_from_json(const char *const json) {
+    meteo_extract me = {meteo_array_new(), 0, -1};
 
-    cJSON *parsed_json = cJSON_Parse(json);
-    if (parsed_json == NULL) {
-        const char *error_ptr = cJSON_GetErrorPtr();
-        if (error_ptr != NULL) {
-            fprintf(stderr, "Error before: %s\n", error_ptr);
-        }
-        return list_weather;
+    if (!cJSON_ExtractPaths(json, strlen(json) + 1, meteo_weather_paths, METEO_FIELDS, meteo_field, &me)) {
+        print_json_error();
     }
 
-    cJSON *consolidated_weather = cJSON_GetObjectItemCaseSensitive(parsed_json, "consolidated_weather");
-    const cJSON *weather = NULL;
-    cJSON_ArrayForEach(weather, consolidated_weather) {
-        meteo* mt;
-        mt = g_new(meteo, 1);
+    return me.weather;
+}
 
-        cJSON *weather_state_name = cJSON_GetObjectItemCaseSensitive(weather, "weather_state_name");
-        if (cJSON_IsString(weather_state_name) && (weather_state_name->valuestring != NULL)) {
-            mt->weather_description = cJSON_Print(weather_state_name);
-        }
+/**
+ * Вывод данных о погоде
+ * @param fp - файл вывода
+ * @param meteo* met - структура с данными о погоде
+ */
+void print_meteo(FILE *fp, const meteo *met) {
+    fprintf(fp, "Дата: %s\n", met->applicable_date);
+    fprintf(fp, "Описание погоды: %s\n", met->weather_description);
+    fprintf(fp, "Скорость ветра: %.15g\n", met->wind_speed);
+    fprintf(fp, "Направление ветра (градусы): %.15g\n", met->wind_direction);
+    fprintf(fp, "Минимальная температура: %.15g\n", met->min_temp);
+    fprintf(fp, "Максимальная температура: %.15g\n", met->max_temp);
+    fprintf(fp, "\n");
+}
+
+/**
+ * Потоковое получение данных по погоде: элементы consolidated_weather разбираются
+ * по мере получения ответа, без разбора и хранения ответа целиком
+ */
+typedef struct {
+    json_stream stream; // состояние потокового разбора ответа
+    GArray *weather; // данные по погоде
+    int error; // 1 - ответ не удалось разобрать
+} weather_stream;
+
+/**
+ * Обработчик элемента consolidated_weather: первый элемент (погода на сегодня) выводится сразу
+ * @param json - json элемента
+ * @param len - размер json
+ * @param userp - weather_stream
+ * @return 0|1 - 0 элемент разобран | 1 элемент не удалось разобрать
+ */
+int weather_stream_item(const char *json, size_t len, void *userp) {
+    weather_stream *ws = userp;
+    if (meteo_from_json(json, len, ws->weather)) {
+        fprintf(stderr, "ERROR: Не удалось разобрать данные по погоде\n");
+        return 1;
+    }
+
+    if (ws->weather->len == 1) {
+        printf("\nПогода на сегодня\n");
+        print_meteo(stdout, &g_array_index(ws->weather, meteo, 0));
+    }
+
+    return 0;
+}
 
-        cJSON *applicable_date = cJSON_GetObjectItemCaseSensitive(weather, "applicable_date");
-        if (cJSON_IsString(applicable_date) && (applicable_date->valuestring != NULL)) {
-            mt->applicable_date = cJSON_Print(applicable_date);
+/**
+ * Обработчик данных ответа: передает полученную порцию потоковому разбору
+ * @return 0|1 - 0 продолжить запрос | 1 прервать запрос
+ */
+int weather_stream_data(const char *data, size_t len, void *userp) {
+    weather_stream *ws = userp;
+    if (!ws->error && json_stream_feed(&ws->stream, data, len)) {
+        ws->error = 1;
+    }
+
+    return ws->error;
+}
+
+static const char *api_url = API_URL; // адрес api, задается HW04_API_URL
+
+/**
+ * Формирование url поиска локации
+ * @param url - буфер результата размером URL_MAX
+ * @param city - название локации
+ */
+void search_url(char *url, const char *city) {
+    snprintf(url, URL_MAX, "%s%s%s", api_url, API_URN_SEARCH, city);
+}
+
+/**
+ * Формирование url данных локации
+ * @param url - буфер результата размером URL_MAX
+ * @param woeid - woeid локации
+ */
+void location_url(char *url, int woeid) {
+    snprintf(url, URL_MAX, "%s%s%d/", api_url, API_URN_LOCATION, woeid);
+}
+
+/**
+ * Путь к файлу кэша: из переменной окружения, иначе файл в домашнем каталоге
+ * @param path - буфер результата
+ * @param size - размер буфера
+ * @param env - переменная окружения с путем к файлу
+ * @param file - имя файла в домашнем каталоге
+ */
+void cache_path(char *path, size_t size, const char *env, const char *file) {
+    const char *value = getenv(env);
+    if (value != NULL && *value) {
+        snprintf(path, size, "%s", value);
+        return;
+    }
+    const char *home = getenv("HOME");
+    snprintf(path, size, "%s/%s", home ? home : ".", file);
+}
+
+/**
+ * Текущее время в секундах для замера длительности запросов
+ */
+double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Данные по одной локации в режиме нескольких локаций
+ */
+typedef struct {
+    const char *city; // название локации
+    int woeid; // woeid локации, 0 пока не получен
+    GArray *weather; // данные по погоде
+    woeid_cache *cache; // кэш woeid, куда сохраняем найденный woeid
+} city_weather;
+
+/**
+ * Обработчик завершения запроса локации: после поиска woeid запускает запрос данных локации
+ * @param request - завершенный запрос
+ * @param code - код ошибки curl
+ * @return 1|0 - 1 задан запрос данных локации | 0 обработка локации завершена
+ */
+int city_request_done(http_request *request, int code) {
+    city_weather *cw = request->userp;
+    if (code) {
+        return 0;
+    }
+
+    if (!cw->woeid) {
+        cw->woeid = woeid_from_json(request->response.data);
+        if (!cw->woeid) {
+            fprintf(stderr, "ERROR: Передана не корректная локация %s\n", cw->city);
+            return 0;
         }
+        woeid_cache_put(cw->cache, cw->city, cw->woeid);
+        location_url(request->url, cw->woeid);
+        return 1;
+    }
+
+    cw->weather = weather_from_json(request->response.data);
+    return 0;
+}
+
+/**
+ * Формат вывода данных по погоде
+ */
+typedef enum {
+    OUTPUT_TEXT, // текст с подписями
+    OUTPUT_CSV, // csv, строка на запись
+    OUTPUT_BINARY // двоичный поколоночный формат
+} output_format;
+
+/**
+ * Числовые колонки машинного вывода
+ */
+enum {
+    COLUMN_WOEID,
+    COLUMN_DAY, // дней от 1970-01-01
+    COLUMN_WIND_SPEED,
+    COLUMN_WIND_DIRECTION,
+    COLUMN_MIN_TEMP,
+    COLUMN_MAX_TEMP,
+    COLUMNS_NUMERIC
+};
+
+static const char *const column_names[COLUMNS_NUMERIC] = {
+    "woeid", "day", "wind_speed", "wind_direction", "min_temp", "max_temp"
+};
+
+/**
+ * Заголовок двоичного формата. За ним следуют колонки по count значений: числовые колонки int32
+ * в порядке COLUMN_*, затем weather_description по METEO_DESCRIPTION_MAX байт с нуль-символом.
+ * Скорость и направление ветра, температуры - в сотых долях. Числа в порядке байт машины,
+ * все колонки выровнены на 4 байта, поэтому файл можно читать через mmap без разбора
+ */
+typedef struct {
+    char magic[8]; // сигнатура и версия формата
+    uint32_t count; // кол-во записей
+    uint32_t columns; // кол-во колонок, включая weather_description
+} meteo_binary_header;
+
+/**
+ * Число с фиксированной точкой (сотые доли) с округлением до ближайшего
+ */
+int32_t fixed_point(double value) {
+    double scaled = value * FIXED_POINT_SCALE;
+    return (int32_t) (scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+}
+
+/**
+ * Значение числовой колонки записи
+ * @param met - запись
+ * @param woeid - woeid локации записи
+ * @param column - колонка COLUMN_*
+ * @return значение колонки
+ */
+int32_t meteo_column(const meteo *met, int woeid, int column) {
+    long day;
+    switch (column) {
+        case COLUMN_WOEID:
+            return woeid;
+        case COLUMN_DAY:
+            return history_date(met->applicable_date, &day) ? EPOCH_DAY_NONE : (int32_t) day;
+        case COLUMN_WIND_SPEED:
+            return fixed_point(met->wind_speed);
+        case COLUMN_WIND_DIRECTION:
+            return fixed_point(met->wind_direction);
+        case COLUMN_MIN_TEMP:
+            return fixed_point(met->min_temp);
+        default:
+            return fixed_point(met->max_temp);
+    }
+}
 
-        cJSON *wind_speed = cJSON_GetObjectItemCaseSensitive(weather, "wind_speed");
-        if (cJSON_IsNumber(wind_speed)) {
-            mt->wind_speed = cJSON_Print(wind_speed);
+/**
+ * Машинный вывод всех записей всех локаций через один буфер вывода
+ * @param cws - данные локаций
+ * @param count - кол-во локаций
+ * @param format - OUTPUT_CSV | OUTPUT_BINARY
+ * @return 0|1 - 0 данные выведены | 1 ошибка записи
+ */
+int output_weather(const city_weather *cws, size_t count, output_format format) {
+    output_buffer *out = malloc(sizeof(output_buffer));
+    if (out == NULL) {
+        fprintf(stderr, "ERROR: Не удалось выделить память.\n");
+        return 1;
+    }
+    output_init(out, stdout);
+
+    if (format == OUTPUT_CSV) {
+        for (int c = 0; c < COLUMNS_NUMERIC; ++c) {
+            output_write(out, column_names[c], strlen(column_names[c]));
+            output_char(out, ',');
+        }
+        output_write(out, "weather_description\n", strlen("weather_description\n"));
+        for (size_t i = 0; i < count; ++i) {
+            for (guint j = 0; cws[i].weather && j < cws[i].weather->len; ++j) {
+                const meteo *met = &g_array_index(cws[i].weather, meteo, j);
+                for (int c = 0; c < COLUMNS_NUMERIC; ++c) {
+                    int32_t value = meteo_column(met, cws[i].woeid, c);
+                    if (c != COLUMN_DAY || value != EPOCH_DAY_NONE) {
+                        output_int(out, value);
+                    }
+                    output_char(out, ',');
+                }
+                output_csv_string(out, met->weather_description);
+                output_char(out, '\n');
+            }
+        }
+    } else {
+        meteo_binary_header header = {METEO_BINARY_MAGIC, 0, COLUMNS_NUMERIC + 1};
+        for (size_t i = 0; i < count; ++i) {
+            header.count += cws[i].weather ? cws[i].weather->len : 0;
         }
+        output_write(out, &header, sizeof(header));
 
-        cJSON *wind_direction = cJSON_GetObjectItemCaseSensitive(weather, "wind_direction");
-        if (cJSON_IsNumber(wind_direction)) {
-            mt->wind_direction = cJSON_Print(wind_direction);
+        /** колонка за колонкой: значения одной колонки всех записей подряд */
+        for (int c = 0; c <= COLUMNS_NUMERIC; ++c) {
+            for (size_t i = 0; i < count; ++i) {
+                for (guint j = 0; cws[i].weather && j < cws[i].weather->len; ++j) {
+                    const meteo *met = &g_array_index(cws[i].weather, meteo, j);
+                    if (c == COLUMNS_NUMERIC) {
+                        output_write(out, met->weather_description, METEO_DESCRIPTION_MAX);
+                    } else {
+                        int32_t value = meteo_column(met, cws[i].woeid, c);
+                        output_write(out, &value, sizeof(value));
+                    }
+                }
+            }
         }
+    }
+
+    int res = output_flush(out);
+    if (res || fflush(stdout)) {
+        fprintf(stderr, "ERROR: Не удалось записать данные по погоде\n");
+        res = 1;
+    }
+    free(out);
 
-        cJSON *min_temp = cJSON_GetObjectItemCaseSensitive(weather, "min_temp");
-        if (cJSON_IsNumber(min_temp)) {
-            mt->min_temp = cJSON_Print(min_temp);
+    return res;
+}
+
+/**
+ * Получение погоды по нескольким локациям.
+ * Запросы всех локаций выполняются одновременно (не более max_parallel), запрос данных локации
+ * запускается сразу по завершении поиска ее woeid. При compare дополнительно выполняются
+ * те же запросы последовательно и выводится время обоих способов
+ * @param client - клиент
+ * @param cache - кэш woeid, локации из кэша запрашиваются сразу без поиска
+ * @param cities - названия локаций
+ * @param count - кол-во локаций
+ * @param max_parallel - максимальное кол-во одновременных запросов
+ * @param compare - 1 сравнить с последовательным выполнением
+ * @param format - формат вывода. В машинных форматах выводятся все дни всех локаций, время - в stderr
+ * @return 0|1 - 0 успешно | 1 ошибка
+ */
+int weather_many(http_client *client, woeid_cache *cache, char **cities, size_t count, size_t max_parallel, int compare,
+                 output_format format) {
+    http_request *requests = calloc(count, sizeof(http_request));
+    city_weather *cws = calloc(count, sizeof(city_weather));
+    if (!requests || !cws) {
+        fprintf(stderr, "ERROR: Не удалось выделить память.\n");
+        exit(1);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        cws[i].city = cities[i];
+        cws[i].cache = cache;
+        cws[i].woeid = woeid_cache_get(cache, cities[i]);
+        requests[i].userp = &cws[i];
+        if (cws[i].woeid) {
+            location_url(requests[i].url, cws[i].woeid);
+        } else {
+            search_url(requests[i].url, cities[i]);
         }
+    }
 
-        cJSON *max_temp = cJSON_GetObjectItemCaseSensitive(weather, "max_temp");
-        if (cJSON_IsNumber(max_temp)) {
-            mt->max_temp = cJSON_Print(max_temp);
+    double start = now_seconds();
+    int res = http_get_many(client, requests, count, max_parallel, city_request_done);
+    double elapsed = now_seconds() - start;
+    FILE *info = format == OUTPUT_TEXT ? stdout : stderr; // машинный вывод в stdout не смешиваем с текстом
+
+    if (format != OUTPUT_TEXT) {
+        res |= output_weather(cws, count, format);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (format == OUTPUT_TEXT) {
+            printf("\nЛокация: %s\n", cws[i].city);
+            if (cws[i].weather && cws[i].weather->len > 0) {
+                print_meteo(stdout, &g_array_index(cws[i].weather, meteo, 0));
+            } else {
+                printf("Не удалось получить данные по локации\n\n");
+            }
         }
+        if (cws[i].weather) {
+            g_array_free(cws[i].weather, TRUE);
+        }
+        http_buffer_free(&requests[i].response);
+    }
+    fprintf(info, "Общее время (одновременно, не более %zu запросов): %.3f с\n", max_parallel, elapsed);
 
-        list_weather = g_slist_append(list_weather, mt);
+    if (compare) {
+        http_buffer response = {0};
+        char url[URL_MAX];
+        start = now_seconds();
+        for (size_t i = 0; i < count; ++i) {
+            int woeid = woeid_cache_get(cache, cities[i]);
+            if (!woeid) {
+                search_url(url, cities[i]);
+                if (http_get(client, url, &response)) {
+                    continue;
+                }
+                if (!(woeid = woeid_from_json(response.data))) {
+                    continue;
+                }
+            }
+            location_url(url, woeid);
+            if (http_get(client, url, &response)) {
+                continue;
+            }
+            g_array_free(weather_from_json(response.data), TRUE);
+        }
+        fprintf(info, "Общее время (последовательно): %.3f с\n", now_seconds() - start);
+        http_buffer_free(&response);
     }
 
-    cJSON_Delete(parsed_json);
+    free(requests);
+    free(cws);
 
-    return list_weather;
+    return res;
 }
 
 /**
- * Метод инициализации глобального буфера данных wr_buf данными полученными запросом curl
- * @param buffer - буфер данных который записываем в глобальную переменную wr_buf
- * @param size
- * @param nmemb
- * @param userp
- * @return 0|<int> - 0 не удалось произвести действия | <int> размер прочитанного в байтах
+ * woeid локации: из кэша, иначе поиском локации с сохранением в кэш
+ * @param client - клиент
+ * @param cache - кэш woeid
+ * @param city - название локации
+ * @param response - буфер ответа
+ * @return 0|<woeid> - 0 локацию не удалось определить | woeid локации
  */
-size_t write_data(void *buffer, size_t size, size_t nmemb, void *userp) {
-    /** Определяем размер полученных данных */
-    int segsize = size * nmemb;
+int city_woeid(http_client *client, woeid_cache *cache, const char *city, http_buffer *response) {
+    int woeid = woeid_cache_get(cache, city);
+    if (woeid) {
+        return woeid;
+    }
 
-    /** Проверяем чтобы размер ответа не превышал буфер результата */
-    if (wr_index + segsize > MAX_BUF) {
-        *(int *) userp = 1;
-        perror("ERROR: Размер данных превышает размер буфера\n");
+    char url[URL_MAX];
+    search_url(url, city);
+    if (http_get(client, url, response)) {
+        fprintf(stderr, "ERROR: Не удалось определить woeid локации\n");
         return 0;
     }
 
-    /** Записываем полученные данные в буфер */
-    memcpy((void *) &wr_buf[wr_index], buffer, (size_t) segsize);
+    woeid = woeid_from_json(response->data);
+    if (!woeid) {
+        fprintf(stderr, "ERROR: Передана не корректная локация\n");
+        return 0;
+    }
+    woeid_cache_put(cache, city, woeid);
+
+    return woeid;
+}
+
+/**
+ * Загрузка архива погоды локации за диапазон дат в каталог
+ * @param client - клиент
+ * @param cache - кэш woeid
+ * @param city - название локации
+ * @param range - диапазон дат <yyyy-mm-dd>:<yyyy-mm-dd>
+ * @param dir - каталог файлов результата
+ * @param max_parallel - максимальное кол-во одновременных запросов
+ * @param retries - кол-во повторов запроса дня после ошибки
+ * @return 0|1 - 0 все дни загружены | 1 ошибка
+ */
+int weather_history(http_client *client, woeid_cache *cache, const char *city, const char *range, const char *dir,
+                    size_t max_parallel, int retries) {
+    history hist = {0};
+    const char *sep = strchr(range, ':');
+    char from[16];
+    if (sep == NULL || (size_t) (sep - range) >= sizeof(from)) {
+        fprintf(stderr, "ERROR: Некорректный диапазон дат %s\n", range);
+        return 1;
+    }
+    memcpy(from, range, (size_t) (sep - range));
+    from[sep - range] = '\0';
+    if (history_date(from, &hist.from) || history_date(sep + 1, &hist.to) || hist.to < hist.from) {
+        fprintf(stderr, "ERROR: Некорректный диапазон дат %s\n", range);
+        return 1;
+    }
+
+    http_buffer response = {0};
+    int woeid = city_woeid(client, cache, city, &response);
+    http_buffer_free(&response);
+    if (!woeid) {
+        return 1;
+    }
+
+    location_url(hist.url, woeid);
+    snprintf(hist.dir, sizeof(hist.dir), "%s", dir);
+    hist.retries = retries;
+
+    double start = now_seconds();
+    int res = history_download(client, &hist, max_parallel);
+    printf("Загружено дней: %zu, уже были загружены: %zu, ошибок: %zu, время: %.3f с\n",
+           hist.loaded, hist.skipped, hist.failed, now_seconds() - start);
 
-    /* Update the write index */
-    wr_index += segsize;
+    return res;
+}
+
+/**
+ * Состояние замера производительности клиента
+ */
+typedef struct {
+    char url[URL_MAX]; // url данных локации
+    double *latency; // длительность каждого запроса вместе с разбором ответа, с
+    size_t total; // кол-во запросов
+    size_t started; // кол-во запущенных запросов
+    size_t done; // кол-во успешно выполненных запросов
+    size_t failed; // кол-во запросов с ошибкой
+} bench;
+
+/**
+ * Обработчик завершения запроса замера: учитывает длительность запроса и разбора ответа,
+ * затем запускает следующий запрос, пока не выполнено заданное кол-во
+ * @param request - завершенный запрос
+ * @param code - код ошибки curl
+ * @return 1|0 - 1 задан следующий запрос | 0 все запросы запущены
+ */
+int bench_request_done(http_request *request, int code) {
+    bench *b = request->userp;
+    if (code || request->status != 200) {
+        b->failed++;
+    } else {
+        double start = now_seconds();
+        g_array_free(weather_from_json(request->response.data), TRUE);
+        b->latency[b->done++] = request->total_time + now_seconds() - start;
+    }
+
+    if (b->started >= b->total) {
+        return 0;
+    }
+    b->started++;
+    snprintf(request->url, URL_MAX, "%s", b->url);
+
+    return 1;
+}
 
-    /* Последним в конец строки символ конца строки */
-    wr_buf[wr_index] = '\0';
+/**
+ * Сравнение длительностей для qsort
+ */
+int compare_latency(const void *a, const void *b) {
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
 
-    /* Возвращаем кол-во полученных байт */
-    return segsize;
+/**
+ * Перцентиль отсортированных длительностей
+ * @param latency - отсортированные длительности
+ * @param count - кол-во длительностей, больше 0
+ * @param p - перцентиль, 0..100
+ * @return длительность, с
+ */
+double percentile(const double *latency, size_t count, double p) {
+    size_t i = (size_t) (p / 100.0 * (double) (count - 1) + 0.5);
+    return latency[i < count ? i : count - 1];
 }
 
 /**
- * Выполнение запроса curl
- * @param url - url которому обращаемся
- * @return 0|<code> - 0 запрос прошел успешно | <code> код ошибки
+ * Замер производительности клиента: total запросов данных локации, не более max_parallel одновременно.
+ * Кэш ответов и объединение запросов не используются, каждый запрос выполняется на сервере,
+ * ответ разбирается так же, как в обычном режиме.
+ * Выводит кол-во запросов в секунду и перцентили p50/p99 длительности запроса
+ * @param client - клиент
+ * @param cache - кэш woeid
+ * @param city - название локации
+ * @param total - кол-во запросов
+ * @param max_parallel - максимальное кол-во одновременных запросов
+ * @param fresh - 1 - новое соединение на каждый запрос, для сравнения с переиспользованием соединений
+ * @return 0|1 - 0 все запросы выполнены | 1 ошибка
  */
-int curl(const char *url) {
-    CURL *curl = NULL;
-    CURLcode res;
-    wr_index = 0;
+int weather_bench(http_client *client, woeid_cache *cache, const char *city, size_t total, size_t max_parallel,
+                  int fresh) {
+    http_buffer response = {0};
+    int woeid = city_woeid(client, cache, city, &response);
+    http_buffer_free(&response);
+    if (!woeid) {
+        return 1;
+    }
 
-    /** Инициализируем curl */
-    curl_global_init(CURL_GLOBAL_DEFAULT);
-    curl = curl_easy_init();
-    if (!curl) {
-        perror("ERROR: Не удалось инициализировать curl.\n");
+    size_t count = max_parallel < total ? max_parallel : total;
+    bench b = {0};
+    location_url(b.url, woeid);
+    b.total = total;
+    b.latency = calloc(total, sizeof(double));
+    http_request *requests = calloc(count, sizeof(http_request));
+    if (!b.latency || !requests) {
+        fprintf(stderr, "ERROR: Не удалось выделить память.\n");
         exit(1);
     }
+    for (size_t i = 0; i < count; ++i) {
+        snprintf(requests[i].url, URL_MAX, "%s", b.url);
+        requests[i].userp = &b;
+    }
+    b.started = count;
 
-    /** устанавливаем опции curl */
-    curl_easy_setopt(curl, CURLOPT_URL, url); // url обращения
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L); // не проверяем ssl
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data); // Указываем в какую функцию передать результат
+    /** каждый запрос должен дойти до сервера: без кэша ответов и без объединения одинаковых запросов */
+    struct response_cache *responses = client->cache;
+    client->cache = NULL;
+    client->single_flight = 0;
+    client->fresh_connect = fresh;
+    double start = now_seconds();
+    int res = http_get_many(client, requests, count, max_parallel, bench_request_done);
+    double elapsed = now_seconds() - start;
+    client->cache = responses;
+    client->single_flight = 1;
+    client->fresh_connect = 0;
 
-    /** непосредственно запрос curl */
-    res = curl_easy_perform(curl);
+    printf("Запросов: %zu, ошибок: %zu, одновременно: %zu, соединения: %s, время: %.3f с, запросов/с: %.1f\n",
+           b.done, b.failed, count, fresh ? "новое на запрос" : "переиспользуются", elapsed,
+           elapsed > 0 ? (double) b.done / elapsed : 0.0);
+    if (b.done > 0) {
+        qsort(b.latency, b.done, sizeof(double), compare_latency);
+        printf("Длительность запроса: p50 %.3f мс, p99 %.3f мс, max %.3f мс\n",
+               percentile(b.latency, b.done, 50) * 1000, percentile(b.latency, b.done, 99) * 1000,
+               b.latency[b.done - 1] * 1000);
+    }
 
-    /* Проверка на ошибки */
-    if (res != CURLE_OK) {
-        fprintf(stderr, "ERROR code=(%d): curl_easy_perform() failed: %s\n", res, curl_easy_strerror(res));
-        curl_easy_cleanup(curl);
-        curl_global_cleanup();
-        return res;
+    for (size_t i = 0; i < count; ++i) {
+        http_buffer_free(&requests[i].response);
     }
+    free(requests);
+    free(b.latency);
 
-    /* останавливаем curl */
-    curl_easy_cleanup(curl);
-    curl_global_cleanup();
+    return res || b.failed > 0;
+}
 
-    return 0;
+/**
+ * Ответ демона по данным локации: все дни прогноза в текстовом виде
+ * @param json - json данных локации
+ * @param city - название локации
+ * @param reply - результат, память освобождается free
+ * @param len - размер результата
+ * @return 0|1 - 0 ответ сформирован | 1 json не удалось разобрать
+ */
+int weather_render(const char *json, const char *city, char **reply, size_t *len) {
+    GArray *weather = weather_from_json(json);
+    FILE *fp = weather->len > 0 ? open_memstream(reply, len) : NULL;
+    if (fp == NULL) {
+        g_array_free(weather, TRUE);
+        return 1;
+    }
+
+    fprintf(fp, "Локация: %s\n", city);
+    for (guint i = 0; i < weather->len; ++i) {
+        print_meteo(fp, &g_array_index(weather, meteo, i));
+    }
+    g_array_free(weather, TRUE);
+
+    return fclose(fp) != 0;
 }
 
 /**
- * Вывод данных о погоде
- * @param meteo* met - структура с данными о погоде
+ * Демон погоды: данные локаций обновляются в памяти и отдаются по Unix socket
+ * @param client - клиент
+ * @param cache - кэш woeid
+ * @param cities - названия локаций
+ * @param count - кол-во локаций
+ * @param socket_path - путь к сокету
+ * @param interval - период обновления, с
+ * @param max_parallel - максимальное кол-во одновременных запросов обновления
+ * @return 0|1 - 0 демон завершен | 1 ошибка
  */
-void print_meteo(meteo *met) {
-    printf("Дата: %s\n", met->applicable_date);
-    printf("Описание погоды: %s\n", met->weather_description);
-    printf("Скорость ветра: %s\n", met->wind_speed);
-    printf("Направление ветра (градусы): %s\n", met->wind_direction);
-    printf("Минимальная температура: %s\n", met->min_temp);
-    printf("Максимальная температура: %s\n", met->max_temp);
-    printf("\n");
+int weather_daemon(http_client *client, woeid_cache *cache, char **cities, size_t count, const char *socket_path,
+                   long interval, size_t max_parallel) {
+    weatherd wd = {0};
+    wd.entries = calloc(count, sizeof(weatherd_entry));
+    if (wd.entries == NULL) {
+        fprintf(stderr, "ERROR: Не удалось выделить память.\n");
+        exit(1);
+    }
+
+    http_buffer response = {0};
+    for (size_t i = 0; i < count; ++i) {
+        int woeid = city_woeid(client, cache, cities[i], &response);
+        if (!woeid) {
+            continue;
+        }
+        weatherd_entry *entry = &wd.entries[wd.count++];
+        entry->city = cities[i];
+        snprintf(entry->woeid, sizeof(entry->woeid), "%d", woeid);
+        location_url(entry->url, woeid);
+    }
+    http_buffer_free(&response);
+
+    /** демон сам хранит актуальные данные, кэш ответов только мешал бы обновлению */
+    client->cache = NULL;
+    wd.client = client;
+    wd.max_parallel = max_parallel;
+    wd.interval = interval;
+    wd.render = weather_render;
+    int res = wd.count > 0 ? weatherd_run(&wd, socket_path) : 1;
+    free(wd.entries);
+
+    return res;
 }
 
+/**
+ * Погода в локации
+ * main <локация> - подробные данные по одной локации
+ * main [-p <кол-во одновременных запросов>] [-s] <локация> <локация> ... - погода на сегодня по нескольким локациям,
+ *     -s дополнительно замеряет время последовательного выполнения тех же запросов
+ * main -H <yyyy-mm-dd>:<yyyy-mm-dd> [-o <каталог>] [-p <кол-во>] [-r <кол-во повторов>] <локация> - архив погоды
+ *     за диапазон дат, по файлу на день
+ * main -f csv|bin [-p <кол-во>] <локация> ... - все дни прогноза всех локаций в машинном формате:
+ *     даты - дни от 1970-01-01, ветер и температуры - сотые доли (см. meteo_binary_header)
+ * main -d <сокет> [-i <период, с>] [-p <кол-во>] <локация> ... - демон: данные локаций обновляются в памяти
+ *     с периодом -i и отдаются по Unix socket
+ * main -c <сокет> <локация|woeid> - запрос данных у демона
+ * main -b <кол-во запросов> [-p <кол-во>] [-n] <локация> - замер производительности клиента (запросов/с, p50/p99),
+ *     -n - новое соединение на каждый запрос, для сравнения с переиспользованием соединений
+ * Адрес api задается переменной окружения HW04_API_URL (например, локальный сервер для замеров tools/mock_api.py)
+ */
 int main(int argc, char *argv[]) {
     /** Проверяем переданы ли все аргументы */
     if (argc < 2) {
@@ -213,46 +868,160 @@ int main(int argc, char *argv[]) {
         exit(1);
     }
 
-    printf("Поиск производим в локации: %s\n", argv[1]);
+    size_t max_parallel = DEFAULT_PARALLEL;
+    int compare = 0;
+    const char *range = NULL; // диапазон дат архива
+    const char *dir = HISTORY_DIR;
+    int retries = HISTORY_RETRIES;
+    output_format format = OUTPUT_TEXT;
+    size_t bench_total = 0;
+    int bench_fresh = 0; // 1 - замер без переиспользования соединений
+    const char *daemon_socket = NULL; // сокет демона
+    const char *query_socket = NULL; // сокет демона, к которому обращаемся
+    long interval = DAEMON_INTERVAL; // период обновления данных локаций демоном, с
+    int first = 1; // индекс первой локации в argv
+    while (first < argc && argv[first][0] == '-') {
+        if (!strcmp(argv[first], "-p") && first + 1 < argc) {
+            max_parallel = strtoul(argv[first + 1], NULL, 10);
+            first += 2;
+        } else if (!strcmp(argv[first], "-H") && first + 1 < argc) {
+            range = argv[first + 1];
+            first += 2;
+        } else if (!strcmp(argv[first], "-o") && first + 1 < argc) {
+            dir = argv[first + 1];
+            first += 2;
+        } else if (!strcmp(argv[first], "-r") && first + 1 < argc) {
+            retries = atoi(argv[first + 1]);
+            first += 2;
+        } else if (!strcmp(argv[first], "-f") && first + 1 < argc) {
+            if (!strcmp(argv[first + 1], "csv")) {
+                format = OUTPUT_CSV;
+            } else if (!strcmp(argv[first + 1], "bin")) {
+                format = OUTPUT_BINARY;
+            } else if (strcmp(argv[first + 1], "text") != 0) {
+                fprintf(stderr, "ERROR: Неизвестный формат вывода %s\n", argv[first + 1]);
+                exit(1);
+            }
+            first += 2;
+        } else if (!strcmp(argv[first], "-d") && first + 1 < argc) {
+            daemon_socket = argv[first + 1];
+            first += 2;
+        } else if (!strcmp(argv[first], "-c") && first + 1 < argc) {
+            query_socket = argv[first + 1];
+            first += 2;
+        } else if (!strcmp(argv[first], "-i") && first + 1 < argc) {
+            interval = strtol(argv[first + 1], NULL, 10);
+            first += 2;
+        } else if (!strcmp(argv[first], "-b") && first + 1 < argc) {
+            bench_total = strtoul(argv[first + 1], NULL, 10);
+            first += 2;
+        } else if (!strcmp(argv[first], "-n")) {
+            bench_fresh = 1;
+            first++;
+        } else if (!strcmp(argv[first], "-s")) {
+            compare = 1;
+            first++;
+        } else {
+            fprintf(stderr, "ERROR: Неизвестный аргумент %s\n", argv[first]);
+            exit(1);
+        }
+    }
+    if (first >= argc || max_parallel == 0) {
+        fprintf(stderr, "ERROR: Переданы не все аргументы.\n");
+        exit(1);
+    }
 
-    /** поиск локации (woeid) */
-    char url_c[1024] = API_URL;
-    char urn_search[1024] = API_URN_SEARCH;
-    strcat(urn_search, argv[1]); // получаем urn для поиска локации
-    strcat(url_c, urn_search); // получаем url поиска локации
-    if (curl(url_c)) {
-        fprintf(stderr, "ERROR: Не удалось определить woeid локации\n");
+    if (query_socket != NULL) {
+        return weatherd_query(query_socket, argv[first]);
+    }
+
+    const char *base = getenv(API_URL_ENV);
+    if (base != NULL && *base) {
+        api_url = base;
+    }
+
+    /** один клиент на все запросы, чтобы запросы переиспользовали соединения */
+    http_client client;
+    if (http_client_init(&client)) {
         exit(1);
     }
 
-    int woeid = woeid_from_json(wr_buf);
-    if(!woeid) {
-        fprintf(stderr, "ERROR: Передана не корректная локация\n");
+    /** кэш woeid: при повторных запусках поиск локации не требуется */
+    char path[URL_MAX];
+    woeid_cache cache;
+    cache_path(path, sizeof(path), WOEID_CACHE_ENV, WOEID_CACHE_FILE);
+    woeid_cache_open(&cache, path);
+
+    /** кэш ответов: актуальные данные локации отдаются без запроса, устаревшие проверяются условным запросом */
+    response_cache responses;
+    const char *ttl = getenv(RESPONSE_CACHE_TTL_ENV);
+    cache_path(path, sizeof(path), RESPONSE_CACHE_ENV, RESPONSE_CACHE_DIR);
+    if (response_cache_open(&responses, path, ttl ? strtol(ttl, NULL, 10) : RESPONSE_CACHE_TTL) == 0) {
+        client.cache = &responses;
+    }
+
+    if (daemon_socket != NULL) {
+        int res = weather_daemon(&client, &cache, &argv[first], (size_t) (argc - first), daemon_socket, interval,
+                                 max_parallel);
+        woeid_cache_close(&cache);
+        http_client_cleanup(&client);
+        return res;
+    }
+
+    if (bench_total > 0) {
+        int res = weather_bench(&client, &cache, argv[first], bench_total, max_parallel, bench_fresh);
+        woeid_cache_close(&cache);
+        http_client_cleanup(&client);
+        return res;
+    }
+
+    if (range != NULL) {
+        int res = weather_history(&client, &cache, argv[first], range, dir, max_parallel, retries);
+        woeid_cache_close(&cache);
+        http_client_cleanup(&client);
+        return res;
+    }
+
+    if (argc - first > 1 || first > 1) {
+        int res = weather_many(&client, &cache, &argv[first], (size_t) (argc - first), max_parallel, compare, format);
+        woeid_cache_close(&cache);
+        http_client_cleanup(&client);
+        return res;
+    }
+
+    printf("Поиск производим в локации: %s\n", argv[first]);
+    http_buffer response = {0}; // буфер ответа, общий для обоих запросов
+
+    /** поиск локации (woeid), если ее нет в кэше */
+    char url[URL_MAX];
+    int woeid = city_woeid(&client, &cache, argv[first], &response);
+    if (!woeid) {
         exit(1);
     }
-    char str_woeid[12];
-    sprintf(str_woeid, "%d", woeid);
 
-    /** получаем данные локации */
-    char url_d[1024] = API_URL;
-    char urn_location[1024] = API_URN_LOCATION;
-    strcat(url_d, urn_location);
-    strcat(url_d, str_woeid);
-    strcat(url_d, "/");
-    if (curl(url_d)) {
+    /** получаем данные локации, разбирая ответ по мере получения */
+    weather_stream ws = {0};
+    ws.weather = meteo_array_new();
+    json_stream_init(&ws.stream, "consolidated_weather", weather_stream_item, &ws);
+    response.on_data = weather_stream_data;
+    response.on_data_userp = &ws;
+    location_url(url, woeid);
+    if (http_get(&client, url, &response) || ws.error) {
         fprintf(stderr, "ERROR: Не удалось получить данные по локации\n");
         exit(1);
     }
-
-    GSList *list_weather = weather_from_json(wr_buf);
-
-    printf("\nПогода на сегодня\n");
-    print_meteo(g_slist_nth_data(list_weather, 0));
+    response.on_data = NULL;
+    json_stream_free(&ws.stream);
 
     printf("\nПогода на несколько дней\n");
-    g_slist_foreach(list_weather, (GFunc)print_meteo, NULL);
+    for (guint i = 0; i < ws.weather->len; ++i) {
+        print_meteo(stdout, &g_array_index(ws.weather, meteo, i));
+    }
 
-    g_slist_free(list_weather); // не знаю, правильно ли освобождаю память, возможно нужно написать функцию и передать ее в g_slist_free_full ()
+    http_buffer_free(&response);
+    woeid_cache_close(&cache);
+    http_client_cleanup(&client);
+    g_array_free(ws.weather, TRUE);
 
     return 0;
 }
@@ -1,4 +1,4 @@
 #!/bin/bash
-gcc -Wall -Wextra -Wpedantic -std=c11 `pkg-config --cflags glib-2.0`  -c *.c
-gcc *.o `pkg-config --libs glib-2.0` -Llib/cJSON -lcJSON -lcurl -o ./bin/main
+gcc -Wall -Wextra -Wpedantic -std=c11 -pthread `pkg-config --cflags glib-2.0`  -c *.c
+gcc *.o `pkg-config --libs glib-2.0` -Llib/cJSON -lcJSON -lcurl -pthread -o ./bin/main
 rm *.o
\ No newline at end of file
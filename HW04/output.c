@@ -0,0 +1,95 @@
+#include <string.h>
+#include "output.h"
+
+/**
+ * Инициализация буфера вывода
+ * @param out - буфер
+ * @param fp - файл вывода
+ */
+void output_init(output_buffer *out, FILE *fp) {
+    out->fp = fp;
+    out->len = 0;
+    out->error = 0;
+}
+
+/**
+ * Запись данных буфера в файл
+ * @param out - буфер
+ * @return 0|1 - 0 данные записаны | 1 ошибка записи (в том числе предыдущей)
+ */
+int output_flush(output_buffer *out) {
+    if (out->len > 0 && fwrite(out->data, 1, out->len, out->fp) != out->len) {
+        out->error = 1;
+    }
+    out->len = 0;
+
+    return out->error;
+}
+
+/**
+ * Добавление данных в буфер. Данные больше буфера записываются в файл напрямую
+ * @param out - буфер
+ * @param data - данные
+ * @param len - размер данных
+ */
+void output_write(output_buffer *out, const void *data, size_t len) {
+    if (out->len + len > OUTPUT_BUFFER_SIZE) {
+        output_flush(out);
+        if (len > OUTPUT_BUFFER_SIZE) {
+            if (fwrite(data, 1, len, out->fp) != len) {
+                out->error = 1;
+            }
+            return;
+        }
+    }
+    memcpy(out->data + out->len, data, len);
+    out->len += len;
+}
+
+/**
+ * Добавление символа в буфер
+ * @param out - буфер
+ * @param c - символ
+ */
+void output_char(output_buffer *out, char c) {
+    if (out->len == OUTPUT_BUFFER_SIZE) {
+        output_flush(out);
+    }
+    out->data[out->len++] = c;
+}
+
+/**
+ * Добавление целого числа в десятичной записи без printf
+ * @param out - буфер
+ * @param value - число
+ */
+void output_int(output_buffer *out, int64_t value) {
+    char digits[24];
+    char *p = digits + sizeof(digits);
+    uint64_t abs = value < 0 ? 0 - (uint64_t) value : (uint64_t) value;
+
+    do {
+        *--p = (char) ('0' + abs % 10);
+        abs /= 10;
+    } while (abs);
+    if (value < 0) {
+        *--p = '-';
+    }
+    output_write(out, p, (size_t) (digits + sizeof(digits) - p));
+}
+
+/**
+ * Добавление строки поля csv: строка в кавычках, кавычки внутри удваиваются
+ * @param out - буфер
+ * @param value - строка
+ */
+void output_csv_string(output_buffer *out, const char *value) {
+    output_char(out, '"');
+    for (const char *p = value; *p; ++p) {
+        if (*p == '"') {
+            output_char(out, '"');
+        }
+        output_char(out, *p);
+    }
+    output_char(out, '"');
+}
@@ -0,0 +1,27 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define OUTPUT_BUFFER_SIZE (1 << 16)
+
+/**
+ * Буфер вывода: данные копируются в буфер и записываются в файл одним fwrite при заполнении
+ */
+typedef struct {
+    FILE *fp; // файл вывода
+    size_t len; // размер данных в буфере
+    int error; // 1 - ошибка записи в файл
+    char data[OUTPUT_BUFFER_SIZE];
+} output_buffer;
+
+void output_init(output_buffer *out, FILE *fp);
+void output_write(output_buffer *out, const void *data, size_t len);
+void output_char(output_buffer *out, char c);
+void output_int(output_buffer *out, int64_t value);
+void output_csv_string(output_buffer *out, const char *value);
+int output_flush(output_buffer *out);
+
+#endif
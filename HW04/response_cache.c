@@ -0,0 +1,210 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "response_cache.h"
+
+#define ENTRY_MAGIC "RESPC001"
+
+/**
+ * Заголовок файла записи кэша. За ним следуют url (url_len байт) и тело ответа (body_len байт)
+ */
+typedef struct {
+    char magic[8]; // сигнатура и версия формата
+    int64_t fetched; // время получения ответа
+    char etag[HTTP_VALIDATOR_MAX];
+    char last_modified[HTTP_VALIDATOR_MAX];
+    uint32_t url_len;
+    uint64_t body_len;
+} entry_header;
+
+/**
+ * Путь к файлу записи кэша: имя файла - хэш FNV-1a от url
+ * @param cache - кэш
+ * @param url - url ответа
+ * @param path - буфер результата
+ * @param size - размер буфера
+ */
+static void entry_path(const response_cache *cache, const char *url, char *path, size_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char *p = url; *p; ++p) {
+        hash ^= (unsigned char) *p;
+        hash *= 1099511628211ULL;
+    }
+    snprintf(path, size, "%s/%016llx.cache", cache->dir, (unsigned long long) hash);
+}
+
+/**
+ * Открытие файла записи и проверка, что запись относится к url, а размер тела из заголовка
+ * совпадает с фактическим размером файла (поврежденная или обрезанная запись считается отсутствующей)
+ * @param cache - кэш
+ * @param url - url ответа
+ * @param header - прочитанный заголовок записи
+ * @return -1|<fd> - -1 записи нет | дескриптор файла, позиция чтения на начале тела
+ */
+static int entry_open(const response_cache *cache, const char *url, entry_header *header) {
+    char path[CACHE_DIR_MAX + 32];
+    entry_path(cache, url, path, sizeof(path));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+
+    size_t url_len = strlen(url);
+    char stored_url[URL_MAX];
+    struct stat st;
+    if (fstat(fd, &st) != 0
+        || read(fd, header, sizeof(entry_header)) != (ssize_t) sizeof(entry_header)
+        || memcmp(header->magic, ENTRY_MAGIC, sizeof(header->magic)) != 0
+        || header->url_len != url_len || url_len >= sizeof(stored_url)
+        || (uint64_t) st.st_size < sizeof(entry_header) + url_len
+        || header->body_len != (uint64_t) st.st_size - sizeof(entry_header) - url_len
+        || read(fd, stored_url, url_len) != (ssize_t) url_len
+        || memcmp(stored_url, url, url_len) != 0) {
+        close(fd);
+        return -1;
+    }
+    header->etag[HTTP_VALIDATOR_MAX - 1] = '\0';
+    header->last_modified[HTTP_VALIDATOR_MAX - 1] = '\0';
+
+    return fd;
+}
+
+/**
+ * Инициализация кэша, каталог создается при отсутствии
+ * @param cache - кэш
+ * @param dir - каталог файлов кэша
+ * @param ttl - время актуальности ответа в секундах
+ * @return 0|1 - 0 кэш готов | 1 каталог недоступен
+ */
+int response_cache_open(response_cache *cache, const char *dir, long ttl) {
+    snprintf(cache->dir, sizeof(cache->dir), "%s", dir);
+    cache->ttl = ttl;
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+        return 1;
+    }
+
+    return access(dir, W_OK) != 0;
+}
+
+/**
+ * Получение сведений о записи кэша
+ * @param cache - кэш
+ * @param url - url ответа
+ * @param meta - сведения о записи
+ * @return 1|0 - 1 запись есть | 0 записи нет
+ */
+int response_cache_meta_get(const response_cache *cache, const char *url, response_cache_meta *meta) {
+    entry_header header;
+    int fd = entry_open(cache, url, &header);
+    if (fd < 0) {
+        return 0;
+    }
+    close(fd);
+
+    meta->fetched = (time_t) header.fetched;
+    memcpy(meta->etag, header.etag, HTTP_VALIDATOR_MAX);
+    memcpy(meta->last_modified, header.last_modified, HTTP_VALIDATOR_MAX);
+
+    return 1;
+}
+
+/**
+ * Чтение тела ответа из кэша в буфер ответа
+ * @param cache - кэш
+ * @param url - url ответа
+ * @param response - буфер ответа
+ * @return 1|0 - 1 ответ прочитан | 0 записи нет или она повреждена
+ */
+int response_cache_read(const response_cache *cache, const char *url, http_buffer *response) {
+    entry_header header;
+    int fd = entry_open(cache, url, &header);
+    if (fd < 0) {
+        return 0;
+    }
+
+    int res = 0;
+    if (header.body_len < SIZE_MAX && !http_buffer_reserve(response, (size_t) header.body_len)) {
+        size_t len = (size_t) header.body_len;
+        size_t done = 0;
+        ssize_t got = 1;
+        while (done < len && (got = read(fd, response->data + done, len - done)) > 0) {
+            done += (size_t) got;
+        }
+        if (done == len) {
+            response->len = len;
+            response->data[len] = '\0';
+            memcpy(response->etag, header.etag, HTTP_VALIDATOR_MAX);
+            memcpy(response->last_modified, header.last_modified, HTTP_VALIDATOR_MAX);
+            res = 1;
+        }
+    }
+    close(fd);
+
+    return res;
+}
+
+/**
+ * Сохранение ответа в кэш. Запись пишется во временный файл и переименовывается,
+ * поэтому параллельно читающие процессы не видят ее частично записанной
+ * @param cache - кэш
+ * @param url - url ответа
+ * @param response - ответ сервера
+ */
+void response_cache_store(const response_cache *cache, const char *url, const http_buffer *response) {
+    char path[CACHE_DIR_MAX + 32], tmp[CACHE_DIR_MAX + 48];
+    entry_path(cache, url, path, sizeof(path));
+    snprintf(tmp, sizeof(tmp), "%s.%ld", path, (long) getpid());
+
+    entry_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ENTRY_MAGIC, sizeof(header.magic));
+    header.fetched = (int64_t) time(NULL);
+    memcpy(header.etag, response->etag, HTTP_VALIDATOR_MAX);
+    memcpy(header.last_modified, response->last_modified, HTTP_VALIDATOR_MAX);
+    header.url_len = (uint32_t) strlen(url);
+    header.body_len = response->len;
+
+    FILE *fp = fopen(tmp, "wb");
+    if (fp == NULL) {
+        return;
+    }
+    int ok = fwrite(&header, sizeof(header), 1, fp) == 1
+             && fwrite(url, 1, header.url_len, fp) == header.url_len
+             && fwrite(response->data, 1, response->len, fp) == response->len;
+    if (fclose(fp) != 0 || !ok || rename(tmp, path) != 0) {
+        unlink(tmp);
+    }
+}
+
+/**
+ * Обновление времени получения записи после успешной проверки актуальности (ответ 304)
+ * @param cache - кэш
+ * @param url - url ответа
+ */
+void response_cache_touch(const response_cache *cache, const char *url) {
+    char path[CACHE_DIR_MAX + 32];
+    entry_header header;
+    int fd = entry_open(cache, url, &header);
+    if (fd < 0) {
+        return;
+    }
+    close(fd);
+
+    entry_path(cache, url, path, sizeof(path));
+    if ((fd = open(path, O_WRONLY)) < 0) {
+        return;
+    }
+    int64_t fetched = (int64_t) time(NULL);
+    if (pwrite(fd, &fetched, sizeof(fetched), offsetof(entry_header, fetched)) != (ssize_t) sizeof(fetched)) {
+        fprintf(stderr, "ERROR: Не удалось обновить запись кэша\n");
+    }
+    close(fd);
+}
@@ -0,0 +1,34 @@
+#ifndef RESPONSE_CACHE_H
+#define RESPONSE_CACHE_H
+
+#include <time.h>
+#include "http.h"
+
+#define CACHE_DIR_MAX 900
+
+/**
+ * Кэш ответов на диске: один файл на url с телом ответа, временем получения и
+ * валидаторами (ETag, Last-Modified) для условных запросов
+ */
+struct response_cache {
+    char dir[CACHE_DIR_MAX]; // каталог файлов кэша
+    long ttl; // время в секундах, в течение которого ответ отдается без обращения к серверу
+};
+typedef struct response_cache response_cache;
+
+/**
+ * Сведения о записи кэша без тела ответа
+ */
+typedef struct {
+    time_t fetched; // время получения (или последней успешной проверки) ответа
+    char etag[HTTP_VALIDATOR_MAX];
+    char last_modified[HTTP_VALIDATOR_MAX];
+} response_cache_meta;
+
+int response_cache_open(response_cache *cache, const char *dir, long ttl);
+int response_cache_meta_get(const response_cache *cache, const char *url, response_cache_meta *meta);
+int response_cache_read(const response_cache *cache, const char *url, http_buffer *response);
+void response_cache_store(const response_cache *cache, const char *url, const http_buffer *response);
+void response_cache_touch(const response_cache *cache, const char *url);
+
+#endif
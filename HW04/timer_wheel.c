@@ -0,0 +1,52 @@
+#include <string.h>
+#include "timer_wheel.h"
+
+/**
+ * Инициализация пустого колеса
+ * @param wheel - колесо
+ */
+void timer_wheel_init(timer_wheel *wheel) {
+    memset(wheel, 0, sizeof(timer_wheel));
+}
+
+/**
+ * Добавление таймера
+ * @param wheel - колесо
+ * @param node - таймер, не должен находиться в колесе
+ * @param ticks - через сколько тактов таймер сработает, 0 - на следующем такте
+ */
+void timer_wheel_add(timer_wheel *wheel, timer_node *node, unsigned long ticks) {
+    if (ticks == 0) {
+        ticks = 1;
+    }
+    size_t slot = (wheel->current + ticks) % TIMER_WHEEL_SLOTS;
+    node->rounds = (ticks - 1) / TIMER_WHEEL_SLOTS;
+    node->next = wheel->slots[slot];
+    wheel->slots[slot] = node;
+}
+
+/**
+ * Переход колеса к следующему такту
+ * @param wheel - колесо
+ * @return NULL|<timer_node*> - NULL сработавших таймеров нет | список сработавших таймеров через next,
+ *                              они удалены из колеса и могут быть добавлены снова
+ */
+timer_node *timer_wheel_tick(timer_wheel *wheel) {
+    wheel->current = (wheel->current + 1) % TIMER_WHEEL_SLOTS;
+
+    timer_node *expired = NULL;
+    timer_node **link = &wheel->slots[wheel->current];
+    while (*link != NULL) {
+        timer_node *node = *link;
+        if (node->rounds > 0) {
+            node->rounds--;
+            link = &node->next;
+            continue;
+        }
+        *link = node->next;
+        node->next = expired;
+        expired = node;
+    }
+
+    return expired;
+}
@@ -0,0 +1,32 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stddef.h>
+
+#define TIMER_WHEEL_SLOTS 256
+
+typedef struct timer_node timer_node;
+
+/**
+ * Таймер колеса. Хранится в структуре владельца, память колесом не выделяется
+ */
+struct timer_node {
+    timer_node *next; // следующий таймер слота или списка сработавших
+    unsigned long rounds; // кол-во полных оборотов колеса до срабатывания
+    void *userp; // данные владельца
+};
+
+/**
+ * Колесо таймеров: слот на такт, таймер с задержкой больше оборота ждет нужное кол-во оборотов.
+ * Добавление и срабатывание таймера O(1) независимо от кол-ва таймеров
+ */
+typedef struct {
+    timer_node *slots[TIMER_WHEEL_SLOTS];
+    size_t current; // слот текущего такта
+} timer_wheel;
+
+void timer_wheel_init(timer_wheel *wheel);
+void timer_wheel_add(timer_wheel *wheel, timer_node *node, unsigned long ticks);
+timer_node *timer_wheel_tick(timer_wheel *wheel);
+
+#endif
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""
+Локальный заглушка-сервер api погоды для замеров и проверки HW04 без сети.
+
+Отдает ответы поиска локации и данных локации (в том числе архива по дням) на тех же путях,
+что и metaweather: /api/location/search/?query=<город>, /api/location/<woeid>/,
+/api/location/<woeid>/<yyyy>/<mm>/<dd>/. Ответы либо записанные (--search, --location),
+либо сгенерированные с заданным кол-вом дней (--days) и дополнительным объемом (--pad).
+Задержка ответа задается --latency и --jitter. Поддерживает keep-alive и ETag/If-None-Match (304).
+
+Запуск:
+    tools/mock_api.py --port 8765 --latency 20 --days 6 &
+    HW04_API_URL=http://127.0.0.1:8765/api ./bin/main -b 1000 -p 16 moscow
+"""
+import argparse
+import json
+import random
+import re
+import socket
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import unquote
+
+LOCATION_RE = re.compile(r"^/api/location/(\d+)/(?:(\d{4})/(\d{2})/(\d{2})/)?$")
+SEARCH_PREFIX = "/api/location/search/?query="
+
+
+def forecast_day(index, date, pad):
+    """Один элемент consolidated_weather"""
+    day = {
+        "id": index,
+        "weather_state_name": "Light Cloud",
+        "applicable_date": date,
+        "wind_speed": 3.5 + index,
+        "wind_direction": 180.25,
+        "min_temp": -1.5 + index,
+        "max_temp": 10.125,
+        "humidity": 50,
+        "predictability": 70,
+    }
+    if pad:
+        day["padding"] = "x" * pad
+    return day
+
+
+def location(woeid, title, days, pad):
+    """Данные локации: прогноз на days дней"""
+    return {
+        "title": title,
+        "woeid": woeid,
+        "consolidated_weather": [forecast_day(i, "2021-05-%02d" % (1 + i % 28), pad) for i in range(days)],
+        "sources": [{"title": "BBC", "url": "http://www.bbc.co.uk/weather/"}],
+    }
+
+
+def make_handler(args, search_body, location_body):
+    class Handler(BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"  # keep-alive, чтобы клиент мог переиспользовать соединения
+
+        def setup(self):
+            super().setup()
+            # заголовки и тело пишутся отдельно: без TCP_NODELAY тело ждет подтверждения (задержка ~40 мс)
+            self.connection.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+
+        def reply(self, status, body=b""):
+            etag = '"%x"' % (hash(body) & 0xffffffff)
+            if status == 200 and self.headers.get("If-None-Match") == etag:
+                status, body = 304, b""
+            self.send_response(status)
+            self.send_header("Content-Type", "application/json")
+            self.send_header("Content-Length", str(len(body)))
+            if status in (200, 304):
+                self.send_header("ETag", etag)
+            self.end_headers()
+            self.wfile.write(body)
+
+        def do_GET(self):
+            if args.latency or args.jitter:
+                time.sleep((args.latency + random.uniform(0, args.jitter)) / 1000.0)
+
+            if self.path.startswith(SEARCH_PREFIX):
+                city = unquote(self.path[len(SEARCH_PREFIX):])
+                body = search_body or json.dumps(
+                    [{"title": city, "location_type": "City", "woeid": args.woeid, "latt_long": "55.75,37.62"}])
+                self.reply(200, body.encode() if isinstance(body, str) else body)
+                return
+
+            match = LOCATION_RE.match(self.path)
+            if match is None:
+                self.reply(404)
+                return
+            woeid = int(match.group(1))
+            if match.group(2):
+                # архив за день - массив прогнозов без обертки локации
+                date = "%s-%s-%s" % match.group(2, 3, 4)
+                body = json.dumps([forecast_day(i, date, args.pad) for i in range(args.days)])
+            else:
+                body = location_body or json.dumps(location(woeid, "Moscow", args.days, args.pad))
+            self.reply(200, body.encode() if isinstance(body, str) else body)
+
+        def log_message(self, *unused):
+            pass
+
+    return Handler
+
+
+class Server(ThreadingHTTPServer):
+    daemon_threads = True
+    request_queue_size = 128  # при очереди по умолчанию (5) одновременные подключения теряют SYN и ждут повтора 1 с
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Заглушка api погоды для HW04")
+    parser.add_argument("--port", type=int, default=8765)
+    parser.add_argument("--latency", type=float, default=0, help="задержка ответа, мс")
+    parser.add_argument("--jitter", type=float, default=0, help="случайная добавка к задержке, до N мс")
+    parser.add_argument("--days", type=int, default=6, help="кол-во дней прогноза в сгенерированном ответе")
+    parser.add_argument("--pad", type=int, default=0, help="доп. байт в каждом дне прогноза")
+    parser.add_argument("--woeid", type=int, default=2122265, help="woeid в сгенерированном ответе поиска")
+    parser.add_argument("--search", help="файл записанного ответа поиска")
+    parser.add_argument("--location", help="файл записанного ответа данных локации")
+    args = parser.parse_args()
+
+    search_body = open(args.search, "rb").read() if args.search else None
+    location_body = open(args.location, "rb").read() if args.location else None
+    server = Server(("127.0.0.1", args.port), make_handler(args, search_body, location_body))
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
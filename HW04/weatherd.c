@@ -0,0 +1,445 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "weatherd.h"
+
+#define WEATHERD_CLIENTS 64 // максимальное кол-во одновременных подключений
+#define WEATHERD_LINE_MAX 256 // максимальная длина запроса
+#define WEATHERD_RETRY 30 // повтор неудачного обновления, с
+#define WEATHERD_JITTER 10 // разброс периода обновления, %
+
+static volatile sig_atomic_t weatherd_signal = 0;
+
+/**
+ * Подключение клиента демона: накопленная часть строки запроса и еще не отправленные ответы
+ */
+typedef struct {
+    int fd;
+    size_t len; // размер данных в line
+    char line[WEATHERD_LINE_MAX];
+    char *out; // ответы, которые сокет еще не принял
+    size_t out_len; // размер данных в out
+    size_t out_sent; // сколько из out уже отправлено
+} weatherd_client;
+
+/**
+ * Обновление одной локации в пачке обновления
+ */
+typedef struct {
+    weatherd *wd;
+    weatherd_entry *entry;
+    int ok; // 1 - данные обновлены
+} weatherd_refresh;
+
+/**
+ * Обработчик SIGINT и SIGTERM: завершение демона
+ */
+static void weatherd_on_signal(int sig) {
+    (void) sig;
+    weatherd_signal = 1;
+}
+
+/**
+ * Период со случайным разбросом +-WEATHERD_JITTER%, чтобы обновления локаций не шли к серверу одной волной
+ * @param wd - демон
+ * @param period - период, с
+ * @return кол-во тактов колеса
+ */
+static unsigned long weatherd_jitter(weatherd *wd, long period) {
+    long spread = period * WEATHERD_JITTER / 100;
+    if (spread == 0) {
+        return (unsigned long) period;
+    }
+
+    return (unsigned long) (period - spread + rand_r(&wd->seed) % (2 * spread + 1));
+}
+
+/**
+ * Обработчик завершения запроса обновления: формирует ответ и подменяет им ответ локации
+ * @param request - завершенный запрос
+ * @param code - код ошибки curl
+ * @return 0 - следующего запроса нет
+ */
+static int weatherd_refresh_done(http_request *request, int code) {
+    weatherd_refresh *refresh = request->userp;
+    weatherd *wd = refresh->wd;
+    weatherd_entry *entry = refresh->entry;
+
+    char *reply;
+    size_t len;
+    if (code || request->status != 200 || wd->render(request->response.data, entry->city, &reply, &len)) {
+        fprintf(stderr, "ERROR: Не удалось обновить данные по локации %s\n", entry->city);
+        return 0;
+    }
+
+    pthread_mutex_lock(&wd->lock);
+    char *old = entry->reply;
+    entry->reply = reply;
+    entry->reply_len = len;
+    entry->updated = time(NULL);
+    pthread_mutex_unlock(&wd->lock);
+    free(old);
+    refresh->ok = 1;
+
+    return 0;
+}
+
+/**
+ * Обновление локаций, таймеры которых сработали, и планирование следующего обновления.
+ * Первое плановое обновление равномерно распределено по периоду, следующие - через период с разбросом,
+ * неудачное обновление повторяется через WEATHERD_RETRY
+ * @param wd - демон
+ * @param due - список сработавших таймеров
+ * @param initial - 1 первоначальная загрузка всех локаций
+ */
+static void weatherd_update(weatherd *wd, timer_node *due, int initial) {
+    size_t count = 0;
+    for (timer_node *node = due; node; node = node->next) {
+        count++;
+    }
+
+    http_request *requests = calloc(count ? count : 1, sizeof(http_request));
+    weatherd_refresh *refresh = calloc(count ? count : 1, sizeof(weatherd_refresh));
+    if (!requests || !refresh) {
+        fprintf(stderr, "ERROR: Не удалось выделить память.\n");
+        exit(1);
+    }
+    size_t i = 0;
+    for (timer_node *node = due; node; node = node->next, ++i) {
+        refresh[i].wd = wd;
+        refresh[i].entry = node->userp;
+        snprintf(requests[i].url, URL_MAX, "%s", refresh[i].entry->url);
+        requests[i].userp = &refresh[i];
+    }
+
+    http_get_many(wd->client, requests, count, wd->max_parallel, weatherd_refresh_done);
+
+    for (i = 0; i < count; ++i) {
+        unsigned long ticks;
+        if (!refresh[i].ok) {
+            ticks = weatherd_jitter(wd, wd->interval < WEATHERD_RETRY ? wd->interval : WEATHERD_RETRY);
+        } else if (initial) {
+            ticks = 1 + (unsigned long) rand_r(&wd->seed) % (unsigned long) wd->interval;
+        } else {
+            ticks = weatherd_jitter(wd, wd->interval);
+        }
+        timer_wheel_add(&wd->wheel, &refresh[i].entry->timer, ticks);
+        http_buffer_free(&requests[i].response);
+    }
+    free(requests);
+    free(refresh);
+}
+
+/**
+ * Поток обновления: раз в секунду колесо таймеров переходит к следующему такту,
+ * локации сработавших таймеров обновляются одной пачкой запросов
+ * @param arg - демон
+ */
+static void *weatherd_refresher(void *arg) {
+    weatherd *wd = arg;
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    while (!atomic_load(&wd->stop)) {
+        next.tv_sec++;
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) == EINTR) {
+        }
+        timer_node *due = timer_wheel_tick(&wd->wheel);
+        if (due != NULL) {
+            weatherd_update(wd, due, 0);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Добавление данных в очередь отправки клиента
+ * @param client - клиент
+ * @param data - данные
+ * @param len - размер данных
+ */
+static void weatherd_client_append(weatherd_client *client, const char *data, size_t len) {
+    char *out = realloc(client->out, client->out_len + len);
+    if (out == NULL) {
+        fprintf(stderr, "ERROR: Не удалось выделить память.\n");
+        exit(1);
+    }
+    memcpy(out + client->out_len, data, len);
+    client->out = out;
+    client->out_len += len;
+}
+
+/**
+ * Отправка очереди клиента, сколько примет сокет без ожидания
+ * @param client - клиент
+ * @return 0|1 - 0 очередь отправлена или ждет готовности сокета | 1 ошибка отправки
+ */
+static int weatherd_client_flush(weatherd_client *client) {
+    while (client->out_sent < client->out_len) {
+        ssize_t n = write(client->fd, client->out + client->out_sent, client->out_len - client->out_sent);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno != EAGAIN && errno != EWOULDBLOCK;
+        }
+        client->out_sent += (size_t) n;
+    }
+    client->out_len = client->out_sent = 0;
+
+    return 0;
+}
+
+/**
+ * Ответ на запрос: "OK <размер>\n<данные>" или "ERR <описание>\n".
+ * Ответ копируется в очередь клиента под блокировкой, отправка идет уже без нее,
+ * чтобы медленный клиент не задерживал обновление данных
+ * @param wd - демон
+ * @param client - клиент
+ * @param query - название или woeid локации
+ * @return 0|1 - 0 ответ отправлен или ждет в очереди | 1 ошибка отправки
+ */
+static int weatherd_reply(weatherd *wd, weatherd_client *client, const char *query) {
+    weatherd_entry *entry = g_hash_table_lookup(wd->index, query);
+    char header[64];
+
+    pthread_mutex_lock(&wd->lock);
+    if (entry != NULL && entry->reply != NULL) {
+        int len = snprintf(header, sizeof(header), "OK %zu\n", entry->reply_len);
+        weatherd_client_append(client, header, (size_t) len);
+        weatherd_client_append(client, entry->reply, entry->reply_len);
+    } else {
+        int len = snprintf(header, sizeof(header), "ERR %s\n",
+                           entry ? "Нет данных по локации" : "Локация не отслеживается");
+        weatherd_client_append(client, header, (size_t) len);
+    }
+    pthread_mutex_unlock(&wd->lock);
+
+    return weatherd_client_flush(client);
+}
+
+/**
+ * Чтение запросов клиента: по строке на запрос, ответ сразу ставится в очередь отправки
+ * @param wd - демон
+ * @param client - клиент
+ * @return 0|1 - 0 подключение продолжается | 1 подключение нужно закрыть
+ */
+static int weatherd_client_read(weatherd *wd, weatherd_client *client) {
+    ssize_t n = read(client->fd, client->line + client->len, WEATHERD_LINE_MAX - client->len);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        return 0;
+    }
+    if (n <= 0) {
+        return 1;
+    }
+    client->len += (size_t) n;
+
+    char *begin = client->line, *end = client->line + client->len, *eol;
+    while ((eol = memchr(begin, '\n', (size_t) (end - begin))) != NULL) {
+        *eol = '\0';
+        if (eol > begin && eol[-1] == '\r') {
+            eol[-1] = '\0';
+        }
+        if (weatherd_reply(wd, client, begin)) {
+            return 1;
+        }
+        begin = eol + 1;
+    }
+
+    client->len = (size_t) (end - begin);
+    memmove(client->line, begin, client->len);
+
+    return client->len == WEATHERD_LINE_MAX; // слишком длинный запрос
+}
+
+/**
+ * Запуск демона: первоначальная загрузка всех локаций, поток обновления и обслуживание запросов
+ * по Unix socket до SIGINT или SIGTERM
+ * @param wd - демон с заполненными client, entries, count, max_parallel, interval, render
+ * @param socket_path - путь к сокету
+ * @return 0|1 - 0 демон завершен по сигналу | 1 ошибка
+ */
+int weatherd_run(weatherd *wd, const char *socket_path) {
+    struct sockaddr_un addr = {0};
+    addr.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "ERROR: Слишком длинный путь к сокету %s\n", socket_path);
+        return 1;
+    }
+    strcpy(addr.sun_path, socket_path);
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(socket_path);
+    if (listen_fd < 0 || bind(listen_fd, (struct sockaddr *) &addr, sizeof(addr)) || listen(listen_fd, 16)) {
+        fprintf(stderr, "ERROR: Не удалось открыть сокет %s: %s\n", socket_path, strerror(errno));
+        if (listen_fd >= 0) {
+            close(listen_fd);
+        }
+        return 1;
+    }
+
+    wd->index = g_hash_table_new(g_str_hash, g_str_equal);
+    timer_wheel_init(&wd->wheel);
+    pthread_mutex_init(&wd->lock, NULL);
+    atomic_init(&wd->stop, 0);
+    wd->seed = (unsigned int) time(NULL) ^ (unsigned int) getpid();
+    if (wd->interval < 1) {
+        wd->interval = 1;
+    }
+
+    /** первоначальная загрузка всех локаций одной пачкой */
+    timer_node *all = NULL;
+    for (size_t i = 0; i < wd->count; ++i) {
+        weatherd_entry *entry = &wd->entries[i];
+        g_hash_table_insert(wd->index, (gpointer) entry->city, entry);
+        g_hash_table_insert(wd->index, entry->woeid, entry);
+        entry->timer.userp = entry;
+        entry->timer.next = all;
+        all = &entry->timer;
+    }
+    weatherd_update(wd, all, 1);
+
+    /** сигналы завершения обрабатывает только основной поток */
+    struct sigaction sa = {0};
+    sa.sa_handler = weatherd_on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+    sigset_t mask, old;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &mask, &old);
+    pthread_t refresher;
+    int started = pthread_create(&refresher, NULL, weatherd_refresher, wd) == 0;
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+    if (!started) {
+        fprintf(stderr, "ERROR: Не удалось запустить поток обновления\n");
+    }
+    printf("Демон запущен: %s, локаций: %zu, период обновления: %ld с\n", socket_path, wd->count, wd->interval);
+    fflush(stdout);
+
+    weatherd_client clients[WEATHERD_CLIENTS];
+    struct pollfd fds[WEATHERD_CLIENTS + 1];
+    size_t clients_count = 0;
+    while (started && !weatherd_signal) {
+        fds[0].fd = listen_fd;
+        fds[0].events = POLLIN;
+        /** пока клиент не забрал ответы, новые запросы от него не читаются */
+        for (size_t i = 0; i < clients_count; ++i) {
+            fds[i + 1].fd = clients[i].fd;
+            fds[i + 1].events = clients[i].out_len > clients[i].out_sent ? POLLOUT : POLLIN;
+        }
+        if (poll(fds, clients_count + 1, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        /** с конца, чтобы на место закрытого подключения вставало уже обработанное */
+        for (size_t i = clients_count; i-- > 0;) {
+            if (fds[i + 1].revents == 0) {
+                continue;
+            }
+            int done = fds[i + 1].events & POLLOUT ? weatherd_client_flush(&clients[i])
+                                                   : weatherd_client_read(wd, &clients[i]);
+            if (done) {
+                close(clients[i].fd);
+                free(clients[i].out);
+                clients[i] = clients[--clients_count];
+            }
+        }
+        if (fds[0].revents & POLLIN) {
+            int fd = accept(listen_fd, NULL, NULL);
+            if (fd >= 0 && clients_count < WEATHERD_CLIENTS && fcntl(fd, F_SETFL, O_NONBLOCK) == 0) {
+                clients[clients_count] = (weatherd_client) {.fd = fd};
+                clients_count++;
+            } else if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    atomic_store(&wd->stop, 1);
+    if (started) {
+        pthread_join(refresher, NULL);
+    }
+    for (size_t i = 0; i < clients_count; ++i) {
+        close(clients[i].fd);
+        free(clients[i].out);
+    }
+    close(listen_fd);
+    unlink(socket_path);
+    for (size_t i = 0; i < wd->count; ++i) {
+        free(wd->entries[i].reply);
+        wd->entries[i].reply = NULL;
+    }
+    g_hash_table_destroy(wd->index);
+    pthread_mutex_destroy(&wd->lock);
+
+    return !started;
+}
+
+/**
+ * Запрос к демону с выводом ответа и времени ответа
+ * @param socket_path - путь к сокету демона
+ * @param query - название или woeid локации
+ * @return 0|1 - 0 данные получены | 1 ошибка
+ */
+int weatherd_query(const char *socket_path, const char *query) {
+    struct sockaddr_un addr = {0};
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *) &addr, sizeof(addr))) {
+        fprintf(stderr, "ERROR: Не удалось подключиться к демону %s: %s\n", socket_path, strerror(errno));
+        if (fd >= 0) {
+            close(fd);
+        }
+        return 1;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    FILE *fp = fdopen(fd, "r+");
+    if (fp == NULL) {
+        close(fd);
+        return 1;
+    }
+    fprintf(fp, "%s\n", query);
+    fflush(fp);
+
+    int res = 1;
+    char header[WEATHERD_LINE_MAX];
+    size_t len;
+    if (fgets(header, sizeof(header), fp) == NULL) {
+        fprintf(stderr, "ERROR: Демон не ответил\n");
+    } else if (sscanf(header, "OK %zu", &len) != 1) {
+        fprintf(stderr, "ERROR: %s", header + (strncmp(header, "ERR ", 4) ? 0 : 4));
+    } else {
+        char *body = malloc(len ? len : 1);
+        if (body != NULL && fread(body, 1, len, fp) == len) {
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            fwrite(body, 1, len, stdout);
+            fprintf(stderr, "Время ответа: %.3f мс\n",
+                    (double) (end.tv_sec - start.tv_sec) * 1e3 + (double) (end.tv_nsec - start.tv_nsec) / 1e6);
+            res = 0;
+        }
+        free(body);
+    }
+    fclose(fp);
+
+    return res;
+}
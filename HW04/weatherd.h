@@ -0,0 +1,58 @@
+#ifndef WEATHERD_H
+#define WEATHERD_H
+
+#include <stddef.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <glib.h>
+#include "http.h"
+#include "timer_wheel.h"
+
+#define WEATHERD_KEY_MAX 16
+
+/**
+ * Формирование ответа демона по json данных локации
+ * @param json - json данных локации
+ * @param city - название локации
+ * @param reply - результат, память освобождается free
+ * @param len - размер результата
+ * @return 0|1 - 0 ответ сформирован | 1 json не удалось разобрать
+ */
+typedef int (*weatherd_render_fn)(const char *json, const char *city, char **reply, size_t *len);
+
+/**
+ * Отслеживаемая локация
+ */
+typedef struct {
+    const char *city; // название локации
+    char woeid[WEATHERD_KEY_MAX]; // woeid строкой, ключ поиска наравне с названием
+    char url[URL_MAX]; // url данных локации
+    char *reply; // готовый ответ на запрос по локации, NULL - данных еще нет
+    size_t reply_len; // размер ответа
+    time_t updated; // время последнего обновления
+    timer_node timer; // таймер следующего обновления
+} weatherd_entry;
+
+/**
+ * Демон погоды: данные отслеживаемых локаций хранятся в памяти уже готовыми ответами и отдаются
+ * по локальному Unix socket. Поток обновления запрашивает данные локаций по колесу таймеров
+ */
+typedef struct {
+    http_client *client; // клиент, используется только потоком обновления
+    weatherd_entry *entries; // отслеживаемые локации (заполняются вызывающим кодом: city, woeid, url)
+    size_t count; // кол-во локаций
+    size_t max_parallel; // максимальное кол-во одновременных запросов обновления
+    long interval; // период обновления, с
+    weatherd_render_fn render; // формирование ответа по json
+    GHashTable *index; // название и woeid строкой -> weatherd_entry
+    timer_wheel wheel; // колесо таймеров обновления, такт - секунда
+    pthread_mutex_t lock; // защищает reply, reply_len, updated
+    atomic_int stop; // 1 - демон завершается
+    unsigned int seed; // состояние генератора разброса времени обновления
+} weatherd;
+
+int weatherd_run(weatherd *wd, const char *socket_path);
+int weatherd_query(const char *socket_path, const char *query);
+
+#endif
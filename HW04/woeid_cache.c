@@ -0,0 +1,209 @@
+#define _DEFAULT_SOURCE
+
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "woeid_cache.h"
+
+#define CACHE_MAGIC "WOEIDC01"
+#define CACHE_SLOTS 4096 // степень двойки
+#define CACHE_NAME_MAX 52
+
+/**
+ * Заголовок файла кэша
+ */
+typedef struct {
+    char magic[8]; // сигнатура и версия формата
+    uint32_t slots; // кол-во ячеек
+    uint32_t count; // кол-во занятых ячеек
+} cache_header;
+
+/**
+ * Ячейка хэш-таблицы. hash == 0 - ячейка свободна
+ */
+typedef struct {
+    uint64_t hash; // хэш нормализованного названия
+    int32_t woeid;
+    char name[CACHE_NAME_MAX]; // нормализованное название
+} cache_slot;
+
+#define CACHE_SIZE (sizeof(cache_header) + CACHE_SLOTS * sizeof(cache_slot))
+
+/**
+ * Нормализация названия локации
+ * @param city - название локации
+ * @param name - результат размером CACHE_NAME_MAX
+ * @return 0|1 - 0 название нормализовано | 1 название слишком длинное или пустое для кэша
+ */
+static int normalize(const char *city, char name[CACHE_NAME_MAX]) {
+    while (isspace((unsigned char) *city)) {
+        city++;
+    }
+    size_t len = strlen(city);
+    while (len > 0 && isspace((unsigned char) city[len - 1])) {
+        len--;
+    }
+    if (len == 0 || len >= CACHE_NAME_MAX) {
+        return 1;
+    }
+
+    memset(name, 0, CACHE_NAME_MAX);
+    for (size_t i = 0; i < len; ++i) {
+        name[i] = (char) tolower((unsigned char) city[i]);
+    }
+
+    return 0;
+}
+
+/**
+ * Хэш FNV-1a, 0 зарезервирован под свободную ячейку
+ */
+static uint64_t name_hash(const char *name) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (; *name; ++name) {
+        hash ^= (unsigned char) *name;
+        hash *= 1099511628211ULL;
+    }
+
+    return hash ? hash : 1;
+}
+
+static cache_header *header(const woeid_cache *cache) {
+    return (cache_header *) cache->map;
+}
+
+static cache_slot *slots(const woeid_cache *cache) {
+    return (cache_slot *) (cache->map + sizeof(cache_header));
+}
+
+/**
+ * Открытие (при отсутствии - создание) файла кэша.
+ * При ошибке кэш работает как пустой и ничего не сохраняет
+ * @param cache - кэш
+ * @param path - путь к файлу кэша
+ * @return 0|1 - 0 кэш открыт | 1 кэш не используется
+ */
+int woeid_cache_open(woeid_cache *cache, const char *path) {
+    cache->fd = -1;
+    cache->map = NULL;
+    cache->size = 0;
+
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return 1;
+    }
+
+    flock(fd, LOCK_EX);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || ((size_t) st.st_size != CACHE_SIZE && ftruncate(fd, 0) != 0)
+        || ftruncate(fd, CACHE_SIZE) != 0) {
+        flock(fd, LOCK_UN);
+        close(fd);
+        return 1;
+    }
+
+    unsigned char *map = mmap(NULL, CACHE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        flock(fd, LOCK_UN);
+        close(fd);
+        return 1;
+    }
+
+    cache->fd = fd;
+    cache->map = map;
+    cache->size = CACHE_SIZE;
+
+    /** новый или поврежденный файл размечаем заново */
+    cache_header *h = header(cache);
+    if (memcmp(h->magic, CACHE_MAGIC, sizeof(h->magic)) != 0 || h->slots != CACHE_SLOTS) {
+        memset(map, 0, CACHE_SIZE);
+        memcpy(h->magic, CACHE_MAGIC, sizeof(h->magic));
+        h->slots = CACHE_SLOTS;
+    }
+    flock(fd, LOCK_UN);
+
+    return 0;
+}
+
+/**
+ * Поиск woeid локации в кэше
+ * @param cache - кэш
+ * @param city - название локации
+ * @return 0|<int> - 0 локации нет в кэше | woeid
+ */
+int woeid_cache_get(const woeid_cache *cache, const char *city) {
+    char name[CACHE_NAME_MAX];
+    if (cache->map == NULL || normalize(city, name)) {
+        return 0;
+    }
+
+    uint64_t hash = name_hash(name);
+    const cache_slot *table = slots(cache);
+    for (uint32_t i = 0; i < CACHE_SLOTS; ++i) {
+        const cache_slot *slot = &table[(hash + i) & (CACHE_SLOTS - 1)];
+        if (slot->hash == 0) {
+            return 0;
+        }
+        if (slot->hash == hash && !strncmp(slot->name, name, CACHE_NAME_MAX)) {
+            return slot->woeid;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Сохранение woeid локации в кэш. Таблица заполняется не более чем на 3/4,
+ * после этого новые локации не сохраняются
+ * @param cache - кэш
+ * @param city - название локации
+ * @param woeid - woeid локации
+ */
+void woeid_cache_put(woeid_cache *cache, const char *city, int woeid) {
+    char name[CACHE_NAME_MAX];
+    if (cache->map == NULL || woeid == 0 || normalize(city, name)) {
+        return;
+    }
+
+    uint64_t hash = name_hash(name);
+    cache_header *h = header(cache);
+    cache_slot *table = slots(cache);
+
+    flock(cache->fd, LOCK_EX);
+    for (uint32_t i = 0; i < CACHE_SLOTS; ++i) {
+        cache_slot *slot = &table[(hash + i) & (CACHE_SLOTS - 1)];
+        if (slot->hash == hash && !strncmp(slot->name, name, CACHE_NAME_MAX)) {
+            slot->woeid = woeid;
+            break;
+        }
+        if (slot->hash == 0) {
+            if (h->count < CACHE_SLOTS / 4 * 3) {
+                memcpy(slot->name, name, CACHE_NAME_MAX);
+                slot->woeid = woeid;
+                slot->hash = hash; // хэш последним: ячейка становится видна уже заполненной
+                h->count++;
+            }
+            break;
+        }
+    }
+    flock(cache->fd, LOCK_UN);
+}
+
+/**
+ * Закрытие кэша
+ * @param cache - кэш
+ */
+void woeid_cache_close(woeid_cache *cache) {
+    if (cache->map != NULL) {
+        munmap(cache->map, cache->size);
+        close(cache->fd);
+    }
+    cache->fd = -1;
+    cache->map = NULL;
+    cache->size = 0;
+}
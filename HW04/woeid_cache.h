@@ -0,0 +1,21 @@
+#ifndef WOEID_CACHE_H
+#define WOEID_CACHE_H
+
+#include <stddef.h>
+
+/**
+ * Кэш woeid локаций на диске: хэш-таблица с открытой адресацией в файле, отображенном в память.
+ * Ключ - нормализованное название локации (без пробелов по краям, латиница в нижнем регистре)
+ */
+typedef struct {
+    int fd; // дескриптор файла кэша, -1 кэш не используется
+    unsigned char *map; // отображение файла в память
+    size_t size; // размер отображения
+} woeid_cache;
+
+int woeid_cache_open(woeid_cache *cache, const char *path);
+int woeid_cache_get(const woeid_cache *cache, const char *city);
+void woeid_cache_put(woeid_cache *cache, const char *city, int woeid);
+void woeid_cache_close(woeid_cache *cache);
+
+#endif